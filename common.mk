@@ -1,22 +1,22 @@
 all: $(LIBUTF)
 
 UTF32_TO_UTF16 = src/utf32_to_utf16.c libutf16/utf32_to_utf16.h \
-  libutf16/utf16_char.h libutf16/utf16_swap.h src/utf16_internal.h
+  libutf16/utf16_char.h libutf16/utf16_arena.h libutf16/utf16_swap.h src/utf16_internal.h src/utf16_simd.h src/utf16_swar.h
 
 UTF16_TO_UTF32 = src/utf16_to_utf32.c libutf16/utf16_to_utf32.h \
-  libutf16/utf16_char.h libutf16/utf16_swap.h src/utf16_internal.h
+  libutf16/utf16_char.h libutf16/utf16_arena.h libutf16/utf16_swap.h src/utf16_internal.h src/utf16_simd.h src/utf16_swar.h
 
 UTF32_TO_UTF8 = src/utf32_to_utf8.c libutf16/utf32_to_utf8.h \
-  libutf16/utf16_char.h libutf16/utf16_swap.h src/utf16_internal.h
+  libutf16/utf16_char.h libutf16/utf16_arena.h libutf16/utf16_swap.h src/utf16_internal.h src/utf16_simd.h src/utf16_swar.h
 
 UTF8_TO_UTF32 = src/utf8_to_utf32.c libutf16/utf8_to_utf32.h \
-  libutf16/utf16_char.h libutf16/utf16_swap.h src/utf16_internal.h
+  libutf16/utf16_char.h libutf16/utf16_arena.h libutf16/utf16_swap.h src/utf16_internal.h src/utf16_simd.h src/utf16_swar.h src/utf8_dfa.h
 
 UTF16_TO_UTF8 = src/utf16_to_utf8.c libutf16/utf16_to_utf8.h \
-  libutf16/utf16_char.h libutf16/utf16_swap.h src/utf16_internal.h
+  libutf16/utf16_char.h libutf16/utf16_arena.h libutf16/utf16_swap.h src/utf16_internal.h src/utf16_simd.h src/utf16_swar.h
 
 UTF8_TO_UTF16 = src/utf8_to_utf16.c libutf16/utf8_to_utf16.h \
-  libutf16/utf16_char.h libutf16/utf16_swap.h src/utf16_internal.h
+  libutf16/utf16_char.h libutf16/utf16_arena.h libutf16/utf16_swap.h src/utf16_internal.h src/utf16_simd.h src/utf16_swar.h src/utf8_dfa.h
 
 UTF8_TO_UTF16_ONE = src/utf8_to_utf16_one.c libutf16/utf8_to_utf16_one.h \
   libutf16/utf16_char.h
@@ -24,12 +24,27 @@ UTF8_TO_UTF16_ONE = src/utf8_to_utf16_one.c libutf16/utf8_to_utf16_one.h \
 UTF16_TO_UTF8_ONE = src/utf16_to_utf8_one.c libutf16/utf16_to_utf8_one.h \
   libutf16/utf16_char.h
 
-UTF8_CSTD = src/utf8_cstd.c libutf16/utf8_cstd.h libutf16/utf16_char.h \
+UTF8_CSTD = src/utf8_cstd.c libutf16/utf8_cstd.h libutf16/utf16_char.h libutf16/utf16_arena.h \
   libutf16/utf8_to_utf16.h libutf16/utf16_to_utf8.h \
   libutf16/utf8_to_utf32.h libutf16/utf32_to_utf8.h \
   libutf16/utf16_to_utf32.h libutf16/utf32_to_utf16.h \
   libutf16/utf8_to_utf16_one.h libutf16/utf16_to_utf8_one.h
 
+UTF8_VALIDATE = src/utf8_validate.c libutf16/utf8_validate.h \
+  libutf16/utf16_char.h src/utf16_simd.h src/utf16_swar.h
+
+UTF16_VALIDATE = src/utf16_validate.c libutf16/utf16_validate.h \
+  libutf16/utf16_char.h libutf16/utf16_arena.h libutf16/utf16_swap.h src/utf16_internal.h src/utf16_simd.h src/utf16_swar.h
+
+UTF32_VALIDATE = src/utf32_validate.c libutf16/utf32_validate.h \
+  libutf16/utf16_char.h libutf16/utf16_arena.h libutf16/utf16_swap.h src/utf16_internal.h src/utf16_simd.h
+
+UTF8_DFA = src/utf8_dfa.c src/utf8_dfa.h src/utf16_swar.h
+
+UTF16_SIMD = src/utf16_simd.c src/utf16_simd.h libutf16/utf16_char.h libutf16/utf16_engine.h
+
+UTF16_ARENA = src/utf16_arena.c libutf16/utf16_arena.h
+
 src/utf32_to_utf16.o:     $(UTF32_TO_UTF16)
 	$(CC)                                                                                                          src/utf32_to_utf16.c    $(CCFLAGS)src/utf32_to_utf16.o
 src/utf32x_to_utf16.o:    $(UTF32_TO_UTF16)
@@ -132,6 +147,30 @@ src/utf16_to_utf8_one.o:  $(UTF16_TO_UTF8_ONE)
 	$(CC)                                                                                                          src/utf16_to_utf8_one.c $(CCFLAGS)src/utf16_to_utf8_one.o
 src/utf8_cstd.o:          $(UTF8_CSTD)
 	$(CC)                                                                                                          src/utf8_cstd.c         $(CCFLAGS)src/utf8_cstd.o
+src/utf8_validate.o:      $(UTF8_VALIDATE)
+	$(CC)                                                                                                          src/utf8_validate.c     $(CCFLAGS)src/utf8_validate.o
+src/utf16_validate.o:     $(UTF16_VALIDATE)
+	$(CC)                                                                                                          src/utf16_validate.c    $(CCFLAGS)src/utf16_validate.o
+src/utf16x_validate.o:    $(UTF16_VALIDATE)
+	$(CC)                                                                                -DSWAP_UTF16              src/utf16_validate.c    $(CCFLAGS)src/utf16x_validate.o
+src/utf16u_validate.o:    $(UTF16_VALIDATE)
+	$(CC)                                        -DUTF_GET_UNALIGNED                                               src/utf16_validate.c    $(CCFLAGS)src/utf16u_validate.o
+src/utf16ux_validate.o:   $(UTF16_VALIDATE)
+	$(CC)                                        -DUTF_GET_UNALIGNED                     -DSWAP_UTF16              src/utf16_validate.c    $(CCFLAGS)src/utf16ux_validate.o
+src/utf32_validate.o:     $(UTF32_VALIDATE)
+	$(CC)                                                                                                          src/utf32_validate.c    $(CCFLAGS)src/utf32_validate.o
+src/utf32x_validate.o:    $(UTF32_VALIDATE)
+	$(CC)                                                                                             -DSWAP_UTF32 src/utf32_validate.c    $(CCFLAGS)src/utf32x_validate.o
+src/utf32u_validate.o:    $(UTF32_VALIDATE)
+	$(CC)                                        -DUTF_GET_UNALIGNED                                               src/utf32_validate.c    $(CCFLAGS)src/utf32u_validate.o
+src/utf32ux_validate.o:   $(UTF32_VALIDATE)
+	$(CC)                                        -DUTF_GET_UNALIGNED                                  -DSWAP_UTF32 src/utf32_validate.c    $(CCFLAGS)src/utf32ux_validate.o
+src/utf8_dfa.o:           $(UTF8_DFA)
+	$(CC)                                                                                                          src/utf8_dfa.c          $(CCFLAGS)src/utf8_dfa.o
+src/utf16_simd.o:         $(UTF16_SIMD)
+	$(CC)                                                                                                          src/utf16_simd.c        $(CCFLAGS)src/utf16_simd.o
+src/utf16_arena.o:        $(UTF16_ARENA)
+	$(CC)                                                                                                          src/utf16_arena.c       $(CCFLAGS)src/utf16_arena.o
 
 OBJS = \
 	src/utf32_to_utf16.o     \
@@ -184,7 +223,19 @@ OBJS = \
 	src/utf8_to_utf16ux.o    \
 	src/utf8_to_utf16_one.o  \
 	src/utf16_to_utf8_one.o  \
-	src/utf8_cstd.o
+	src/utf8_cstd.o          \
+	src/utf8_validate.o      \
+	src/utf16_validate.o     \
+	src/utf16x_validate.o    \
+	src/utf16u_validate.o    \
+	src/utf16ux_validate.o   \
+	src/utf32_validate.o     \
+	src/utf32x_validate.o    \
+	src/utf32u_validate.o    \
+	src/utf32ux_validate.o   \
+	src/utf8_dfa.o           \
+	src/utf16_simd.o         \
+	src/utf16_arena.o
 
 $(LIBUTF): $(OBJS)
 	$(AR) $(ARFLAGS)$(LIBUTF) $(OBJS)
@@ -195,5 +246,11 @@ $(TEST): tests/test.c tests/test_data.inl $(LIBUTF)
 check: $(TEST)
 	$(TEST_RUN)
 
+$(BENCH): tests/bench.c $(LIBUTF)
+	$(CC) tests/bench.c $(BLINK) $(LIBUTF)
+
+benchmark: $(BENCH)
+	$(BENCH_RUN)
+
 clean:
 	$(CLEAN)
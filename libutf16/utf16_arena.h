@@ -0,0 +1,74 @@
+#ifndef UTF16_ARENA_H_INCLUDED
+#define UTF16_ARENA_H_INCLUDED
+
+/**********************************************************************************
+* Arena allocator for converted strings
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf16_arena.h */
+
+#include <stddef.h> /* for size_t */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  arena - a bump allocator of memory for converted strings, used by the _arena conversion functions
+  (e.g. utf8_to_utf16_arena()).
+
+  memory is taken from chunks, allocated via malloc(), allocated blocks are not freed individually:
+  all of them are released at once by utf_arena_reset(), which keeps the chunks for reuse,
+  so that, e.g., strings of a request may be converted without calling malloc()/free() for each of them.
+
+  note: an arena is not thread-safe, it should be used by one thread at a time (e.g. one arena per worker thread).
+*/
+
+/* alignment of blocks allocated from an arena, in bytes */
+#define UTF_ARENA_ALIGN 8
+
+/* default size of arena chunks, in bytes */
+#define UTF_ARENA_CHUNK_SIZE 65536
+
+/* chunk of an arena, followed by its memory */
+typedef struct utf_arena_chunk {
+	struct utf_arena_chunk *next; /* next chunk, NULL if this is the last one */
+	size_t size;                  /* size of chunk memory, in bytes */
+} utf_arena_chunk_t;
+
+typedef struct utf_arena {
+	utf_arena_chunk_t *first; /* list of chunks, NULL if no chunks were allocated yet */
+	utf_arena_chunk_t *cur;   /* current chunk, NULL if nothing was allocated since initialization/reset */
+	unsigned char *pos;       /* beginning of free memory of the current chunk */
+	unsigned char *end;       /* end of memory of the current chunk */
+	size_t chunk_size;        /* minimal size of newly allocated chunks, in bytes */
+} utf_arena_t;
+
+/* initialize an empty arena, chunk_size - minimal size of chunks, in bytes, 0 - UTF_ARENA_CHUNK_SIZE,
+  memory for chunks is allocated on demand */
+void utf_arena_init(
+	utf_arena_t *const a/*out,!=NULL*/,
+	const size_t chunk_size/*0?*/);
+
+/* allocate a block of memory of given size from the arena,
+  the block is aligned on UTF_ARENA_ALIGN bytes boundary,
+  returns NULL if there is not enough memory */
+void *utf_arena_alloc(
+	utf_arena_t *const a/*in,out,!=NULL*/,
+	const size_t size/*0?*/);
+
+/* release all blocks allocated from the arena at once, keeping its chunks for reuse */
+void utf_arena_reset(
+	utf_arena_t *const a/*in,out,!=NULL*/);
+
+/* free all chunks of the arena, the arena becomes empty and may be used again */
+void utf_arena_destroy(
+	utf_arena_t *const a/*in,out,!=NULL*/);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UTF16_ARENA_H_INCLUDED */
@@ -90,10 +90,34 @@ typedef unsigned char utf8_char_t;
 /* maximum length of utf8-encoded unicode character in bytes */
 #define UTF8_MAX_LEN 4
 
+/* size of the padding of input and output buffers, in bytes, required by the _pad conversion functions */
+#define UTF_BUF_PADDING 64
+
 /* to declare pointers to unaligned buffers containing utf16/utf32 characters */
 typedef unsigned char utf16_char_unaligned_t[sizeof(utf16_char_t)];
 typedef unsigned char utf32_char_unaligned_t[sizeof(utf32_char_t)];
 
+/* growable output buffer of the _grow conversion functions */
+typedef struct utf_grow_buf {
+	void *buf;  /* output buffer, NULL if not allocated yet */
+	size_t len; /* number of utf8_char_t's/utf16_char_t's/utf32_char_t's stored in the buffer */
+	size_t cap; /* size of the buffer, in utf8_char_t's/utf16_char_t's/utf32_char_t's */
+	/* function to resize the buffer to given size in bytes, returns NULL if there is not enough memory,
+	  if NULL, realloc() is used */
+	void *(*realloc_fn)(void *ctx, void *buf, size_t size);
+	void *ctx;  /* context passed to realloc_fn */
+} utf_grow_buf_t;
+
+/* token of validated input string, filled by the _size_token functions and accepted only by the _from_token ones
+  of the same conversion with the same form of input (e.g. utf16x_to_utf8_size_token() and utf16x_to_utf8_from_token(),
+  or utf8_to_utf16_size_token() and utf8_to_utf16ux_from_token()) */
+typedef struct utf_valid_token {
+	const void *src; /* valid input string, NULL if the token is empty */
+	size_t n;        /* number of utf8_char_t's/utf16_char_t's/utf32_char_t's of the input string */
+	size_t size;     /* size of the converted string, in utf8_char_t's/utf16_char_t's/utf32_char_t's */
+	unsigned kind;   /* kind of the conversion which filled the token, 0 if the token is empty */
+} utf_valid_token_t;
+
 /* utf8 <-> utf16 conversion state */
 typedef unsigned int utf8_state_t;
 
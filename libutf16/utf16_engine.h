@@ -0,0 +1,49 @@
+#ifndef UTF16_ENGINE_H_INCLUDED
+#define UTF16_ENGINE_H_INCLUDED
+
+/**********************************************************************************
+* Selection of conversion engines
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf16_engine.h */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  bulk conversion functions (utf8/utf16/utf32 string converters) may use SIMD engines to speed up conversions,
+  an engine is selected at run time, on first conversion, as the best one supported by the cpu.
+
+  for debugging and benchmarking, engines may be limited by the LIBUTF16_ENGINE environment variable
+  (read once, on first conversion), with one of the values:
+
+  scalar - use only portable c code,
+  avx2   - do not use engines above AVX2,
+  avx512 - do not use engines above AVX-512 (the default).
+
+  note: an engine not supported by the cpu (or not compiled into the library) is never used,
+   limiting engines to it selects the best supported engine below it.
+*/
+
+/* engines, in order of preference */
+#define LIBUTF16_ENGINE_SCALAR  0
+#define LIBUTF16_ENGINE_AVX2    1
+#define LIBUTF16_ENGINE_AVX512  2
+
+/* returns engine used by conversion functions - one of LIBUTF16_ENGINE_... */
+int libutf16_engine(void);
+
+/* limit engines used by conversion functions, overriding LIBUTF16_ENGINE environment variable:
+  engine - one of LIBUTF16_ENGINE_..., negative - reset to the default (the best one supported by the cpu),
+  returns engine that will be used - as libutf16_engine() */
+/* note: not thread-safe: should not be called while conversions are performed in other threads */
+int libutf16_set_engine(const int engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UTF16_ENGINE_H_INCLUDED */
@@ -0,0 +1,79 @@
+#ifndef UTF16_VALIDATE_H_INCLUDED
+#define UTF16_VALIDATE_H_INCLUDED
+
+/**********************************************************************************
+* UTF-16 strings validation
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf16_validate.h */
+
+#include "utf16_char.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  group of functions for checking that utf16 string is valid:
+
+  utf16{,u}{,x}_validate{,_z}
+
+  functions modifiers:
+   x - exchange byte order when reading from buffer,
+   u - assume buffer is unaligned
+*/
+
+/* ------------------------------------------------------------------------------------------ */
+
+/* check that utf16 0-terminated string is valid, without converting it,
+ input:
+  q - address of the pointer to the beginning of input 0-terminated utf16 string.
+ returns non-zero if utf16 string is valid:
+  (*q) - points beyond the 0-terminator of input utf16 string;
+ returns 0 if utf16 string is invalid:
+  (*q) - points beyond last valid utf16_char_t (to first invalid bytes),
+   . last valid utf16_char_t is _not_ 0 */
+
+#define TEMPL_UTF16_VALIDATE_Z(name, it) \
+int name( \
+	const it/*utf16_char_t,utf16_char_unaligned_t*/ **const q/*in,out,!=NULL*/)
+
+TEMPL_UTF16_VALIDATE_Z(utf16_validate_z, utf16_char_t);
+TEMPL_UTF16_VALIDATE_Z(utf16x_validate_z, utf16_char_t);
+TEMPL_UTF16_VALIDATE_Z(utf16u_validate_z, utf16_char_unaligned_t);
+TEMPL_UTF16_VALIDATE_Z(utf16ux_validate_z, utf16_char_unaligned_t);
+
+#undef TEMPL_UTF16_VALIDATE_Z
+
+/* ------------------------------------------------------------------------------------------ */
+
+/* check that 'n' utf16_char_t's form valid utf16 string, without converting them,
+ input:
+  q - address of the pointer to the beginning of input utf16 string,
+  n - number of utf16_char_t's to check, if zero - input buffer is not used.
+ returns non-zero if 'n' is zero or utf16 string is valid:
+  (*q) - points beyond last source utf16_char_t of input string;
+ returns 0 if utf16 string is invalid:
+  (*q) - points beyond last valid utf16_char_t (to first invalid bytes),
+   . last valid utf16_char_t is _not_ the last character of utf16 string */
+/* Note: zero utf16_char_t is not treated specially, i.e. validation do not stops */
+
+#define TEMPL_UTF16_VALIDATE(name, it) \
+int name( \
+	const it/*utf16_char_t,utf16_char_unaligned_t*/ **const q/*in,out,!=NULL if n>0*/, \
+	const size_t n/*0?*/)
+
+TEMPL_UTF16_VALIDATE(utf16_validate, utf16_char_t);
+TEMPL_UTF16_VALIDATE(utf16x_validate, utf16_char_t);
+TEMPL_UTF16_VALIDATE(utf16u_validate, utf16_char_unaligned_t);
+TEMPL_UTF16_VALIDATE(utf16ux_validate, utf16_char_unaligned_t);
+
+#undef TEMPL_UTF16_VALIDATE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UTF16_VALIDATE_H_INCLUDED */
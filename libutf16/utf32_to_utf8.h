@@ -10,6 +10,7 @@
 /* utf32_to_utf8.h */
 
 #include "utf16_char.h"
+#include "utf16_arena.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,7 +19,7 @@ extern "C" {
 /*
   group of functions for converting utf32 string to utf8 string:
 
-  utf32{,u}{,x}_to_utf8{{,_z}{,_size,_partial,_unsafe},_z_size_e}
+  utf32{,u}{,x}_to_utf8{{,_z}{,_size,_partial,_unsafe},_z_size_e,_alloc,_grow,{,_z}_size_token,_from_token,_arena}
 
   such as:
 
@@ -31,6 +32,12 @@ extern "C" {
   utf32_to_utf8_z_partial
   utf32_to_utf8_z_unsafe
   utf32_to_utf8_z_size_e
+  utf32_to_utf8_alloc
+  utf32_to_utf8_grow
+  utf32_to_utf8_size_token
+  utf32_to_utf8_z_size_token
+  utf32_to_utf8_from_token
+  utf32_to_utf8_arena
   ...
 
   functions modifiers:
@@ -184,6 +191,194 @@ TEMPL_UTF32_TO_UTF8_(utf32ux_to_utf8_, utf32_char_unaligned_t);
 
 /* ------------------------------------------------------------------------------------------ */
 
+/* maximum number of utf8_char_t's produced by converting 'n' utf32_char_t's to utf8 ones:
+  each utf32_char_t produces at most 4 utf8_char_t's */
+#define UTF32_TO_UTF8_MAX(n) (4*(n))
+
+/* convert 'n' utf32_char_t's to utf8 ones in one pass, allocating output buffer of UTF32_TO_UTF8_MAX(n) utf8_char_t's,
+ input:
+  w      - address of the pointer to the beginning of input utf32 string,
+  b      - address of the pointer to set to the allocated output buffer,
+  n      - number of utf32_char_t's to convert (to convert 0-terminated string, include the 0-terminator),
+  shrink - if non-zero, shrink the output buffer to the size of converted utf8 string via realloc().
+ returns number of stored utf8_char_t's:
+  0          - if 'n' is zero or an invalid/incomplete utf32 character is encountered,
+  (size_t)-1 - if there is not enough memory,
+  else       - all 'n' utf32_char_t's were successfully converted to utf8 ones;
+ - on success:
+  (*w) - points beyond last source utf32_char_t of input string,
+  (*b) - points to the allocated output buffer, which must be freed via free();
+ - on error:
+  (*w) - if input utf32 string is invalid, points beyond last valid utf32_char_t, else - not changed,
+  (*b) - NULL */
+/* Note: output buffers returned by malloc() are suitably aligned, so there are no unaligned-output variants */
+/* Note: zero utf32_char_t is not treated specially, i.e. conversion do not stops */
+
+#define TEMPL_UTF32_TO_UTF8_ALLOC(name, it) \
+size_t name( \
+	const it/*utf32_char_t,utf32_char_unaligned_t*/ **const LIBUTF16_RESTRICT w/*in,out,!=NULL if n>0*/, \
+	utf8_char_t **const LIBUTF16_RESTRICT b/*out,!=NULL*/, \
+	const size_t n/*0?*/, \
+	const int shrink)
+
+TEMPL_UTF32_TO_UTF8_ALLOC(utf32_to_utf8_alloc, utf32_char_t);
+TEMPL_UTF32_TO_UTF8_ALLOC(utf32x_to_utf8_alloc, utf32_char_t);
+TEMPL_UTF32_TO_UTF8_ALLOC(utf32u_to_utf8_alloc, utf32_char_unaligned_t);
+TEMPL_UTF32_TO_UTF8_ALLOC(utf32ux_to_utf8_alloc, utf32_char_unaligned_t);
+
+#undef TEMPL_UTF32_TO_UTF8_ALLOC
+
+/* ------------------------------------------------------------------------------------------ */
+
+/* convert 'n' utf32_char_t's to utf8 ones in one pass, appending them to the growable output buffer,
+ input:
+  w - address of the pointer to the beginning of input utf32 string,
+  g - growable output buffer: g->buf - array of g->cap utf8_char_t's (may be NULL if g->cap is zero),
+    converted utf8_char_t's are stored starting from g->buf[g->len],
+  n - number of utf32_char_t's to convert, if zero - input and output buffers are not used.
+ if the output buffer becomes full, it is reallocated (at least doubling its capacity) via g->realloc_fn
+  or realloc(), and the conversion is continued from the last converted utf32_char_t, without rescanning the input.
+ returns number of utf8_char_t's appended to the output buffer:
+  0          - if 'n' is zero or an invalid/incomplete utf32 character is encountered,
+  (size_t)-1 - if there is not enough memory,
+  else       - all 'n' utf32_char_t's were successfully converted to utf8 ones;
+ - in all cases:
+  (*w) - points beyond last converted utf32_char_t (to first invalid bytes or past the end of string),
+  g->len - advanced by the number of converted utf8_char_t's stored in the output buffer,
+  g->buf, g->cap - describe the (possibly reallocated) output buffer, which remains owned by the caller */
+/* Note: an incomplete utf32 character at the end of the input is not converted, so a string read by chunks
+  may be converted by passing the unconverted tail of the chunk together with the next chunk */
+/* Note: zero utf32_char_t is not treated specially, i.e. conversion do not stops */
+
+#define TEMPL_UTF32_TO_UTF8_GROW(name, it) \
+size_t name( \
+	const it/*utf32_char_t,utf32_char_unaligned_t*/ **const LIBUTF16_RESTRICT w/*in,out,!=NULL if n>0*/, \
+	utf_grow_buf_t *const LIBUTF16_RESTRICT g/*in,out,!=NULL*/, \
+	size_t n/*0?*/)
+
+TEMPL_UTF32_TO_UTF8_GROW(utf32_to_utf8_grow, utf32_char_t);
+TEMPL_UTF32_TO_UTF8_GROW(utf32x_to_utf8_grow, utf32_char_t);
+TEMPL_UTF32_TO_UTF8_GROW(utf32u_to_utf8_grow, utf32_char_unaligned_t);
+TEMPL_UTF32_TO_UTF8_GROW(utf32ux_to_utf8_grow, utf32_char_unaligned_t);
+
+#undef TEMPL_UTF32_TO_UTF8_GROW
+
+/* ------------------------------------------------------------------------------------------ */
+
+/* same as utf32_to_utf8_size(), but also fills the token of validated input string,
+ input:
+  w - address of the pointer to the beginning of input utf32 string,
+  n - number of utf32_char_t's to convert, if zero - input buffer is not used,
+  t - token to fill.
+ returns non-zero size of resulting buffer, in utf8_char_t's, on success:
+  (*w) - not changed,
+  t    - refers to 'n' valid utf32_char_t's at (*w);
+ returns 0 if 'n' is zero or utf32 string is invalid:
+  (*w) - points beyond last valid utf32_char_t,
+  t    - is empty */
+/* Note: zero utf32_char_t is not treated specially, i.e. conversion do not stops */
+
+#define TEMPL_UTF32_TO_UTF8_SIZE_TOKEN(name, it) \
+size_t name( \
+	const it/*utf32_char_t,utf32_char_unaligned_t*/ **const LIBUTF16_RESTRICT w/*in,out,!=NULL if n>0*/, \
+	const size_t n/*0?*/, \
+	utf_valid_token_t *const LIBUTF16_RESTRICT t/*out,!=NULL*/)
+
+TEMPL_UTF32_TO_UTF8_SIZE_TOKEN(utf32_to_utf8_size_token, utf32_char_t);
+TEMPL_UTF32_TO_UTF8_SIZE_TOKEN(utf32x_to_utf8_size_token, utf32_char_t);
+TEMPL_UTF32_TO_UTF8_SIZE_TOKEN(utf32u_to_utf8_size_token, utf32_char_unaligned_t);
+TEMPL_UTF32_TO_UTF8_SIZE_TOKEN(utf32ux_to_utf8_size_token, utf32_char_unaligned_t);
+
+#undef TEMPL_UTF32_TO_UTF8_SIZE_TOKEN
+
+/* same as utf32_to_utf8_size_token(), but for 0-terminated utf32 string,
+ input:
+  w - address of the pointer to the beginning of input 0-terminated utf32 string,
+  t - token to fill.
+ returns non-zero size of resulting buffer, in utf8_char_t's, including terminating 0, on success:
+  (*w) - not changed,
+  t    - refers to valid utf32_char_t's at (*w), including the terminating 0;
+ returns 0 if utf32 string is invalid:
+  (*w) - points beyond last valid utf32_char_t,
+  t    - is empty */
+/* Note: the token is converted by utf32_to_utf8{...}_from_token() together with the terminating 0, there are
+  no _z_from_token functions: the length of the string is already known, so it is not searched for 0 again */
+
+#define TEMPL_UTF32_TO_UTF8_Z_SIZE_TOKEN(name, it) \
+size_t name( \
+	const it/*utf32_char_t,utf32_char_unaligned_t*/ **const LIBUTF16_RESTRICT w/*in,out,!=NULL*/, \
+	utf_valid_token_t *const LIBUTF16_RESTRICT t/*out,!=NULL*/)
+
+TEMPL_UTF32_TO_UTF8_Z_SIZE_TOKEN(utf32_to_utf8_z_size_token, utf32_char_t);
+TEMPL_UTF32_TO_UTF8_Z_SIZE_TOKEN(utf32x_to_utf8_z_size_token, utf32_char_t);
+TEMPL_UTF32_TO_UTF8_Z_SIZE_TOKEN(utf32u_to_utf8_z_size_token, utf32_char_unaligned_t);
+TEMPL_UTF32_TO_UTF8_Z_SIZE_TOKEN(utf32ux_to_utf8_z_size_token, utf32_char_unaligned_t);
+
+#undef TEMPL_UTF32_TO_UTF8_Z_SIZE_TOKEN
+
+/* convert utf32 string validated by a utf32_to_utf8{...}_size_token() function to utf8 one, without validating it again,
+ input:
+  t  - the token filled by utf32_to_utf8{...}_size_token(), the input string must not be changed since then,
+  b  - address of the pointer to the beginning of output buffer (not used if sz < t->size),
+  sz - free space in output buffer, in utf8_char_t's.
+ returns 0 if the token is empty or was filled by another conversion or for another form of input
+  (nothing is stored), else returns t->size:
+  <= sz - the string was converted, (*b) - points beyond last converted utf8_char_t stored in the output buffer,
+  > sz  - output buffer is too small, (*b) - not changed, nothing is stored */
+/* Note: if a SIMD engine is used, it converts the string - its validation is nearly free, and the engine
+  is faster than the unchecked scalar code of utf32_to_utf8_unsafe(), which is used otherwise */
+
+#define TEMPL_UTF32_TO_UTF8_FROM_TOKEN(name) \
+size_t name( \
+	const utf_valid_token_t *const LIBUTF16_RESTRICT t/*in,!=NULL*/, \
+	utf8_char_t **const LIBUTF16_RESTRICT b/*in,out,!=NULL if sz>0*/, \
+	const size_t sz/*0?*/)
+
+TEMPL_UTF32_TO_UTF8_FROM_TOKEN(utf32_to_utf8_from_token);
+TEMPL_UTF32_TO_UTF8_FROM_TOKEN(utf32x_to_utf8_from_token);
+TEMPL_UTF32_TO_UTF8_FROM_TOKEN(utf32u_to_utf8_from_token);
+TEMPL_UTF32_TO_UTF8_FROM_TOKEN(utf32ux_to_utf8_from_token);
+
+#undef TEMPL_UTF32_TO_UTF8_FROM_TOKEN
+
+/* ------------------------------------------------------------------------------------------ */
+
+/* same as utf32_to_utf8_alloc(), but allocates output buffer from the arena (see libutf16/utf16_arena.h),
+ input:
+  w - address of the pointer to the beginning of input utf32 string,
+  b - address of the pointer to set to the output buffer allocated from the arena,
+  n - number of utf32_char_t's to convert (to convert 0-terminated string, include the 0-terminator),
+  a - the arena.
+ returns number of stored utf8_char_t's:
+  0          - if 'n' is zero or an invalid/incomplete utf32 character is encountered,
+  (size_t)-1 - if there is not enough memory,
+  else       - all 'n' utf32_char_t's were successfully converted to utf8 ones;
+ - on success:
+  (*w) - points beyond last source utf32_char_t of input string,
+  (*b) - points to the output buffer, which is released by utf_arena_reset() or utf_arena_destroy();
+ - on error:
+  (*w) - if input utf32 string is invalid, points beyond last valid utf32_char_t, else - not changed,
+  (*b) - NULL, nothing is allocated from the arena */
+/* Note: if output buffer of UTF32_TO_UTF8_MAX(n) utf8_char_t's fits in an arena chunk, it is allocated and then
+  its unused tail is returned to the arena, else - exact size of the buffer is determined by a separate pass */
+/* Note: zero utf32_char_t is not treated specially, i.e. conversion do not stops */
+
+#define TEMPL_UTF32_TO_UTF8_ARENA(name, it) \
+size_t name( \
+	const it/*utf32_char_t,utf32_char_unaligned_t*/ **const LIBUTF16_RESTRICT w/*in,out,!=NULL if n>0*/, \
+	utf8_char_t **const LIBUTF16_RESTRICT b/*out,!=NULL*/, \
+	const size_t n/*0?*/, \
+	utf_arena_t *const LIBUTF16_RESTRICT a/*in,out,!=NULL*/)
+
+TEMPL_UTF32_TO_UTF8_ARENA(utf32_to_utf8_arena, utf32_char_t);
+TEMPL_UTF32_TO_UTF8_ARENA(utf32x_to_utf8_arena, utf32_char_t);
+TEMPL_UTF32_TO_UTF8_ARENA(utf32u_to_utf8_arena, utf32_char_unaligned_t);
+TEMPL_UTF32_TO_UTF8_ARENA(utf32ux_to_utf8_arena, utf32_char_unaligned_t);
+
+#undef TEMPL_UTF32_TO_UTF8_ARENA
+
+/* ------------------------------------------------------------------------------------------ */
+
 /* for converting remaining part of the source utf32 0-terminated string after calling utf32_to_utf8_z():
   - assume source string is valid,
   - do not check if there is enough space in output buffer, assume it is large enough.
@@ -0,0 +1,79 @@
+#ifndef UTF32_VALIDATE_H_INCLUDED
+#define UTF32_VALIDATE_H_INCLUDED
+
+/**********************************************************************************
+* UTF-32 strings validation
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf32_validate.h */
+
+#include "utf16_char.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+  group of functions for checking that utf32 string is valid:
+
+  utf32{,u}{,x}_validate{,_z}
+
+  functions modifiers:
+   x - exchange byte order when reading from buffer,
+   u - assume buffer is unaligned
+*/
+
+/* ------------------------------------------------------------------------------------------ */
+
+/* check that utf32 0-terminated string is valid, without converting it,
+ input:
+  q - address of the pointer to the beginning of input 0-terminated utf32 string.
+ returns non-zero if utf32 string is valid:
+  (*q) - points beyond the 0-terminator of input utf32 string;
+ returns 0 if utf32 string is invalid:
+  (*q) - points beyond last valid utf32_char_t (to first invalid bytes),
+   . last valid utf32_char_t is _not_ 0 */
+
+#define TEMPL_UTF32_VALIDATE_Z(name, it) \
+int name( \
+	const it/*utf32_char_t,utf32_char_unaligned_t*/ **const q/*in,out,!=NULL*/)
+
+TEMPL_UTF32_VALIDATE_Z(utf32_validate_z, utf32_char_t);
+TEMPL_UTF32_VALIDATE_Z(utf32x_validate_z, utf32_char_t);
+TEMPL_UTF32_VALIDATE_Z(utf32u_validate_z, utf32_char_unaligned_t);
+TEMPL_UTF32_VALIDATE_Z(utf32ux_validate_z, utf32_char_unaligned_t);
+
+#undef TEMPL_UTF32_VALIDATE_Z
+
+/* ------------------------------------------------------------------------------------------ */
+
+/* check that 'n' utf32_char_t's form valid utf32 string, without converting them,
+ input:
+  q - address of the pointer to the beginning of input utf32 string,
+  n - number of utf32_char_t's to check, if zero - input buffer is not used.
+ returns non-zero if 'n' is zero or utf32 string is valid:
+  (*q) - points beyond last source utf32_char_t of input string;
+ returns 0 if utf32 string is invalid:
+  (*q) - points beyond last valid utf32_char_t (to first invalid bytes),
+   . last valid utf32_char_t is _not_ the last character of utf32 string */
+/* Note: zero utf32_char_t is not treated specially, i.e. validation do not stops */
+
+#define TEMPL_UTF32_VALIDATE(name, it) \
+int name( \
+	const it/*utf32_char_t,utf32_char_unaligned_t*/ **const q/*in,out,!=NULL if n>0*/, \
+	const size_t n/*0?*/)
+
+TEMPL_UTF32_VALIDATE(utf32_validate, utf32_char_t);
+TEMPL_UTF32_VALIDATE(utf32x_validate, utf32_char_t);
+TEMPL_UTF32_VALIDATE(utf32u_validate, utf32_char_unaligned_t);
+TEMPL_UTF32_VALIDATE(utf32ux_validate, utf32_char_unaligned_t);
+
+#undef TEMPL_UTF32_VALIDATE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UTF32_VALIDATE_H_INCLUDED */
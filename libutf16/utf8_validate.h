@@ -0,0 +1,47 @@
+#ifndef UTF8_VALIDATE_H_INCLUDED
+#define UTF8_VALIDATE_H_INCLUDED
+
+/**********************************************************************************
+* UTF-8 strings validation
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf8_validate.h */
+
+#include "utf16_char.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* check that utf8 0-terminated string is valid, without converting it,
+ input:
+  q - address of the pointer to the beginning of input 0-terminated utf8 string.
+ returns non-zero if utf8 string is valid:
+  (*q) - points beyond the 0-terminator of input utf8 string;
+ returns 0 if utf8 string is invalid:
+  (*q) - points beyond last valid utf8_char_t (to first invalid bytes),
+   . last valid utf8_char_t is _not_ 0 */
+int utf8_validate_z(
+	const utf8_char_t **const q/*in,out,!=NULL*/);
+
+/* check that 'n' utf8_char_t's form valid utf8 string, without converting them,
+ input:
+  q - address of the pointer to the beginning of input utf8 string,
+  n - number of utf8_char_t's to check, if zero - input buffer is not used.
+ returns non-zero if 'n' is zero or utf8 string is valid:
+  (*q) - points beyond last source utf8_char_t of input string;
+ returns 0 if utf8 string is invalid or its last utf8 character is incomplete:
+  (*q) - points beyond last valid utf8_char_t (to first invalid bytes),
+   . last valid utf8_char_t is _not_ the last character of utf8 string */
+/* Note: zero utf8_char_t is not treated specially, i.e. validation do not stops */
+int utf8_validate(
+	const utf8_char_t **const q/*in,out,!=NULL if n>0*/,
+	const size_t n/*0?*/);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UTF8_VALIDATE_H_INCLUDED */
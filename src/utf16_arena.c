@@ -0,0 +1,77 @@
+/**********************************************************************************
+* Arena allocator for converted strings
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf16_arena.c */
+
+#include <stddef.h> /* for size_t */
+#include <stdlib.h> /* for malloc()/free() */
+
+#include "libutf16/utf16_arena.h"
+
+/* chunk memory follows the chunk header, which size must keep the memory aligned */
+typedef int utf_arena_check_chunk_t[1-2*(sizeof(utf_arena_chunk_t) % UTF_ARENA_ALIGN != 0)];
+
+void utf_arena_init(utf_arena_t *const a, const size_t chunk_size)
+{
+	a->first = NULL;
+	a->cur = NULL;
+	a->pos = NULL;
+	a->end = NULL;
+	a->chunk_size = chunk_size ? chunk_size : UTF_ARENA_CHUNK_SIZE;
+}
+
+void *utf_arena_alloc(utf_arena_t *const a, const size_t size)
+{
+	unsigned char *p = a->pos;
+	utf_arena_chunk_t *c;
+	const size_t sz = (size + (UTF_ARENA_ALIGN - 1)) & ~(size_t)(UTF_ARENA_ALIGN - 1);
+	if (sz < size)
+		return NULL; /* size is too big */
+	if (p && sz <= (size_t)(a->end - p)) {
+		a->pos = p + sz;
+		return p; /* ok, fits in the current chunk */
+	}
+	/* use the next chunk, if it was kept by utf_arena_reset() and is large enough */
+	c = a->cur ? a->cur->next : a->first;
+	if (!c || c->size < sz) {
+		/* allocate new chunk and insert it after the current one */
+		const size_t n = sz > a->chunk_size ? sz : a->chunk_size;
+		utf_arena_chunk_t *const k = n <= (size_t)-1 - sizeof(*k) ?
+			(utf_arena_chunk_t*)malloc(sizeof(*k) + n) : NULL;
+		if (!k)
+			return NULL; /* not enough memory */
+		k->next = c;
+		k->size = n;
+		if (a->cur)
+			a->cur->next = k;
+		else
+			a->first = k;
+		c = k;
+	}
+	a->cur = c;
+	p = (unsigned char*)(c + 1);
+	a->pos = p + sz;
+	a->end = p + c->size;
+	return p;
+}
+
+void utf_arena_reset(utf_arena_t *const a)
+{
+	a->cur = NULL;
+	a->pos = NULL;
+	a->end = NULL;
+}
+
+void utf_arena_destroy(utf_arena_t *const a)
+{
+	utf_arena_chunk_t *c = a->first;
+	while (c) {
+		utf_arena_chunk_t *const n = c->next;
+		free(c);
+		c = n;
+	}
+	utf_arena_init(a, a->chunk_size);
+}
@@ -83,4 +83,78 @@
 # define UTF_PUT_U
 #endif
 
+/* kinds of tokens of validated strings (utf_valid_token_t): the conversion and the form of its input,
+  the form of output does not matter - it does not change the size of the converted string */
+
+#define UTF_TOKEN_UTF8_TO_UTF16   1
+#define UTF_TOKEN_UTF8_TO_UTF32   2
+#define UTF_TOKEN_UTF16_TO_UTF8   3
+#define UTF_TOKEN_UTF16_TO_UTF32  4
+#define UTF_TOKEN_UTF32_TO_UTF8   5
+#define UTF_TOKEN_UTF32_TO_UTF16  6
+
+#ifdef UTF_GET_UNALIGNED
+# define UTF_TOKEN_GET_U 8
+#else
+# define UTF_TOKEN_GET_U 0
+#endif
+
+#ifdef SWAP_UTF16
+# define UTF16_TOKEN_X 16
+#else
+# define UTF16_TOKEN_X 0
+#endif
+
+#ifdef SWAP_UTF32
+# define UTF32_TOKEN_X 16
+#else
+# define UTF32_TOKEN_X 0
+#endif
+
+#include <stdlib.h> /* for malloc()/realloc() */
+
+#include "libutf16/utf16_arena.h"
+
+/* allocate output buffer of *_alloc conversions for n elements of given size,
+  returns NULL if there is not enough memory or n*size overflows */
+static inline void *utf_alloc_buf(const size_t n, const size_t size)
+{
+	return n <= (size_t)-1/size ? malloc(n*size) : NULL;
+}
+
+/* shrink output buffer of *_alloc conversions to the given size (non-zero), in bytes,
+  returns the original buffer if realloc() fails */
+static inline void *utf_shrink_buf(void *const buf, const size_t size)
+{
+	void *const p = realloc(buf, size);
+	return p ? p : buf;
+}
+
+/* grow output buffer of _grow conversions at least to g->len + k elements of given size (k > 0),
+  at least doubling its capacity, returns 0 if there is not enough memory */
+static inline int utf_grow_buf(utf_grow_buf_t *const g, const size_t k, const size_t size)
+{
+	const size_t max = (size_t)-1/size;
+	size_t cap = g->cap <= max/2 ? 2*g->cap : max;
+	void *p;
+	if (cap - g->len < k)
+		cap = k <= max - g->len ? g->len + k : max;
+	if (cap <= g->cap)
+		return 0; /* cannot grow */
+	p = g->realloc_fn ? g->realloc_fn(g->ctx, g->buf, cap*size) : realloc(g->buf, cap*size);
+	if (!p)
+		return 0; /* not enough memory */
+	g->buf = p;
+	g->cap = cap;
+	return 1;
+}
+
+/* return unused tail of the block allocated last from the arena to it, p - new end of the block */
+static inline void utf_arena_trim(utf_arena_t *const a, const void *const p)
+{
+	unsigned char *const m = (unsigned char*)(a->cur + 1);
+	const size_t o = (size_t)((const unsigned char*)p - m);
+	a->pos = m + ((o + (UTF_ARENA_ALIGN - 1)) & ~(size_t)(UTF_ARENA_ALIGN - 1));
+}
+
 #endif /* UTF16_INTERNAL_H_INCLUDED */
@@ -0,0 +1,1263 @@
+/**********************************************************************************
+* SIMD engines support for utf8/utf16/utf32 conversions
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf16_simd.c */
+
+#include <stddef.h> /* for size_t */
+
+#ifndef _MSC_VER
+#include <stdint.h> /* for uint16_t/uint32_t */
+#endif
+
+#include <memory.h> /* for memcpy() */
+
+#include "libutf16/utf16_char.h"
+#include "libutf16/utf16_engine.h"
+#include "utf16_simd.h"
+
+#ifdef LIBUTF16_AVX2
+
+#include <stdlib.h> /* for getenv() */
+#include <string.h> /* for strcmp()/memchr() */
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define utf_cpuid(r, leaf, sub)   __cpuidex((int*)(r), (int)(leaf), (int)(sub))
+#define utf_cpuid_max()           utf_cpuid_max_()
+static unsigned utf_cpuid_max_(void)
+{
+	unsigned r[4];
+	utf_cpuid(r, 0, 0);
+	return r[0];
+}
+#define utf_xgetbv()              ((unsigned)_xgetbv(0))
+#else
+#include <cpuid.h>
+#define utf_cpuid(r, leaf, sub)   __cpuid_count(leaf, sub, (r)[0], (r)[1], (r)[2], (r)[3])
+#define utf_cpuid_max()           __get_cpuid_max(0, NULL)
+static unsigned utf_xgetbv(void)
+{
+	unsigned a, d;
+	__asm__ __volatile__ ("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+	(void)d;
+	return a;
+}
+#endif
+
+unsigned libutf16_cpu_features_ = 0;
+
+/* engines limit: LIBUTF16_ENGINE_..., -1 - no limit, -2 - not read from environment yet */
+static int libutf16_engine_limit = -2;
+
+static unsigned utf_cpu_detect_hw(void)
+{
+	unsigned f = UTF_CPU_DETECTED;
+	const unsigned max_leaf = utf_cpuid_max();
+	if (max_leaf >= 7) {
+		unsigned r1[4], r7[4];
+		utf_cpuid(r1, 1, 0);
+		utf_cpuid(r7, 7, 0);
+		/* OSXSAVE, AVX and POPCNT */
+		if ((r1[2] & (1u << 27 | 1u << 28 | 1u << 23)) == (1u << 27 | 1u << 28 | 1u << 23)) {
+			/* OS saves XMM and YMM state */
+			const unsigned xcr0 = utf_xgetbv();
+			if ((xcr0 & 6) == 6 && (r7[1] & (1u << 5)/*AVX2*/)) {
+				f |= UTF_CPU_AVX2;
+#ifdef LIBUTF16_AVX512
+				/* OS saves opmask and ZMM state, AVX512F, AVX512BW, AVX512VL, BMI1, BMI2 */
+				if ((xcr0 & 0xE0) == 0xE0 &&
+					(r7[1] & (1u << 16 | 1u << 30 | 1u << 31 | 1u << 3 | 1u << 8)) == (1u << 16 | 1u << 30 | 1u << 31 | 1u << 3 | 1u << 8) &&
+					(r7[2] & (1u << 1 | 1u << 6)) == (1u << 1 | 1u << 6)/*AVX512VBMI, AVX512VBMI2*/)
+				{
+					f |= UTF_CPU_AVX512;
+				}
+#endif
+			}
+		}
+	}
+	return f;
+}
+
+static int utf_engine_limit_from_env(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+#pragma warning(suppress:4996) /* getenv() may be unsafe */
+#endif
+	const char *const e = getenv("LIBUTF16_ENGINE");
+	if (e) {
+		if (!strcmp(e, "scalar"))
+			return LIBUTF16_ENGINE_SCALAR;
+		if (!strcmp(e, "avx2"))
+			return LIBUTF16_ENGINE_AVX2;
+		if (!strcmp(e, "avx512"))
+			return LIBUTF16_ENGINE_AVX512;
+	}
+	return -1; /* unknown values are ignored */
+}
+
+unsigned libutf16_cpu_detect(void)
+{
+	unsigned f = utf_cpu_detect_hw();
+	int limit = libutf16_engine_limit;
+	if (-2 == limit)
+		libutf16_engine_limit = limit = utf_engine_limit_from_env();
+	if (LIBUTF16_ENGINE_SCALAR == limit)
+		f &= UTF_CPU_DETECTED;
+	else if (LIBUTF16_ENGINE_AVX2 == limit)
+		f &= UTF_CPU_DETECTED | UTF_CPU_AVX2;
+	/* note: cached value may be written by concurrent threads, but all of them write the same value */
+	libutf16_cpu_features_ = f;
+	return f;
+}
+
+const unsigned char libutf16_pack16_shuf[256][16] = {
+	{0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x80,0x80,0x80,0x80},
+	{0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80},
+	{0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0e,0x0f,0x80,0x80},
+	{0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x02,0x03,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f}
+};
+
+const unsigned char libutf16_utf8_pack32_shuf[256][16] = {
+	{0x00,0x04,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80}
+};
+
+const unsigned char libutf16_utf8_pack32_len_shuf[256][16] = {
+	{0x00,0x04,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x80,0x80},
+	{0x00,0x04,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x80},
+	{0x00,0x04,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0c,0x0d,0x0e,0x0f,0x80},
+	{0x00,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80},
+	{0x00,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x00,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80},
+	{0x00,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80,0x80},
+	{0x00,0x01,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80,0x80},
+	{0x00,0x01,0x02,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x80},
+	{0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f}
+};
+
+const unsigned char libutf16_pack32_perm[256][8] = {
+	{0,0,0,0,0,0,0,0},
+	{0,0,0,0,0,0,0,0},
+	{1,0,0,0,0,0,0,0},
+	{0,1,0,0,0,0,0,0},
+	{2,0,0,0,0,0,0,0},
+	{0,2,0,0,0,0,0,0},
+	{1,2,0,0,0,0,0,0},
+	{0,1,2,0,0,0,0,0},
+	{3,0,0,0,0,0,0,0},
+	{0,3,0,0,0,0,0,0},
+	{1,3,0,0,0,0,0,0},
+	{0,1,3,0,0,0,0,0},
+	{2,3,0,0,0,0,0,0},
+	{0,2,3,0,0,0,0,0},
+	{1,2,3,0,0,0,0,0},
+	{0,1,2,3,0,0,0,0},
+	{4,0,0,0,0,0,0,0},
+	{0,4,0,0,0,0,0,0},
+	{1,4,0,0,0,0,0,0},
+	{0,1,4,0,0,0,0,0},
+	{2,4,0,0,0,0,0,0},
+	{0,2,4,0,0,0,0,0},
+	{1,2,4,0,0,0,0,0},
+	{0,1,2,4,0,0,0,0},
+	{3,4,0,0,0,0,0,0},
+	{0,3,4,0,0,0,0,0},
+	{1,3,4,0,0,0,0,0},
+	{0,1,3,4,0,0,0,0},
+	{2,3,4,0,0,0,0,0},
+	{0,2,3,4,0,0,0,0},
+	{1,2,3,4,0,0,0,0},
+	{0,1,2,3,4,0,0,0},
+	{5,0,0,0,0,0,0,0},
+	{0,5,0,0,0,0,0,0},
+	{1,5,0,0,0,0,0,0},
+	{0,1,5,0,0,0,0,0},
+	{2,5,0,0,0,0,0,0},
+	{0,2,5,0,0,0,0,0},
+	{1,2,5,0,0,0,0,0},
+	{0,1,2,5,0,0,0,0},
+	{3,5,0,0,0,0,0,0},
+	{0,3,5,0,0,0,0,0},
+	{1,3,5,0,0,0,0,0},
+	{0,1,3,5,0,0,0,0},
+	{2,3,5,0,0,0,0,0},
+	{0,2,3,5,0,0,0,0},
+	{1,2,3,5,0,0,0,0},
+	{0,1,2,3,5,0,0,0},
+	{4,5,0,0,0,0,0,0},
+	{0,4,5,0,0,0,0,0},
+	{1,4,5,0,0,0,0,0},
+	{0,1,4,5,0,0,0,0},
+	{2,4,5,0,0,0,0,0},
+	{0,2,4,5,0,0,0,0},
+	{1,2,4,5,0,0,0,0},
+	{0,1,2,4,5,0,0,0},
+	{3,4,5,0,0,0,0,0},
+	{0,3,4,5,0,0,0,0},
+	{1,3,4,5,0,0,0,0},
+	{0,1,3,4,5,0,0,0},
+	{2,3,4,5,0,0,0,0},
+	{0,2,3,4,5,0,0,0},
+	{1,2,3,4,5,0,0,0},
+	{0,1,2,3,4,5,0,0},
+	{6,0,0,0,0,0,0,0},
+	{0,6,0,0,0,0,0,0},
+	{1,6,0,0,0,0,0,0},
+	{0,1,6,0,0,0,0,0},
+	{2,6,0,0,0,0,0,0},
+	{0,2,6,0,0,0,0,0},
+	{1,2,6,0,0,0,0,0},
+	{0,1,2,6,0,0,0,0},
+	{3,6,0,0,0,0,0,0},
+	{0,3,6,0,0,0,0,0},
+	{1,3,6,0,0,0,0,0},
+	{0,1,3,6,0,0,0,0},
+	{2,3,6,0,0,0,0,0},
+	{0,2,3,6,0,0,0,0},
+	{1,2,3,6,0,0,0,0},
+	{0,1,2,3,6,0,0,0},
+	{4,6,0,0,0,0,0,0},
+	{0,4,6,0,0,0,0,0},
+	{1,4,6,0,0,0,0,0},
+	{0,1,4,6,0,0,0,0},
+	{2,4,6,0,0,0,0,0},
+	{0,2,4,6,0,0,0,0},
+	{1,2,4,6,0,0,0,0},
+	{0,1,2,4,6,0,0,0},
+	{3,4,6,0,0,0,0,0},
+	{0,3,4,6,0,0,0,0},
+	{1,3,4,6,0,0,0,0},
+	{0,1,3,4,6,0,0,0},
+	{2,3,4,6,0,0,0,0},
+	{0,2,3,4,6,0,0,0},
+	{1,2,3,4,6,0,0,0},
+	{0,1,2,3,4,6,0,0},
+	{5,6,0,0,0,0,0,0},
+	{0,5,6,0,0,0,0,0},
+	{1,5,6,0,0,0,0,0},
+	{0,1,5,6,0,0,0,0},
+	{2,5,6,0,0,0,0,0},
+	{0,2,5,6,0,0,0,0},
+	{1,2,5,6,0,0,0,0},
+	{0,1,2,5,6,0,0,0},
+	{3,5,6,0,0,0,0,0},
+	{0,3,5,6,0,0,0,0},
+	{1,3,5,6,0,0,0,0},
+	{0,1,3,5,6,0,0,0},
+	{2,3,5,6,0,0,0,0},
+	{0,2,3,5,6,0,0,0},
+	{1,2,3,5,6,0,0,0},
+	{0,1,2,3,5,6,0,0},
+	{4,5,6,0,0,0,0,0},
+	{0,4,5,6,0,0,0,0},
+	{1,4,5,6,0,0,0,0},
+	{0,1,4,5,6,0,0,0},
+	{2,4,5,6,0,0,0,0},
+	{0,2,4,5,6,0,0,0},
+	{1,2,4,5,6,0,0,0},
+	{0,1,2,4,5,6,0,0},
+	{3,4,5,6,0,0,0,0},
+	{0,3,4,5,6,0,0,0},
+	{1,3,4,5,6,0,0,0},
+	{0,1,3,4,5,6,0,0},
+	{2,3,4,5,6,0,0,0},
+	{0,2,3,4,5,6,0,0},
+	{1,2,3,4,5,6,0,0},
+	{0,1,2,3,4,5,6,0},
+	{7,0,0,0,0,0,0,0},
+	{0,7,0,0,0,0,0,0},
+	{1,7,0,0,0,0,0,0},
+	{0,1,7,0,0,0,0,0},
+	{2,7,0,0,0,0,0,0},
+	{0,2,7,0,0,0,0,0},
+	{1,2,7,0,0,0,0,0},
+	{0,1,2,7,0,0,0,0},
+	{3,7,0,0,0,0,0,0},
+	{0,3,7,0,0,0,0,0},
+	{1,3,7,0,0,0,0,0},
+	{0,1,3,7,0,0,0,0},
+	{2,3,7,0,0,0,0,0},
+	{0,2,3,7,0,0,0,0},
+	{1,2,3,7,0,0,0,0},
+	{0,1,2,3,7,0,0,0},
+	{4,7,0,0,0,0,0,0},
+	{0,4,7,0,0,0,0,0},
+	{1,4,7,0,0,0,0,0},
+	{0,1,4,7,0,0,0,0},
+	{2,4,7,0,0,0,0,0},
+	{0,2,4,7,0,0,0,0},
+	{1,2,4,7,0,0,0,0},
+	{0,1,2,4,7,0,0,0},
+	{3,4,7,0,0,0,0,0},
+	{0,3,4,7,0,0,0,0},
+	{1,3,4,7,0,0,0,0},
+	{0,1,3,4,7,0,0,0},
+	{2,3,4,7,0,0,0,0},
+	{0,2,3,4,7,0,0,0},
+	{1,2,3,4,7,0,0,0},
+	{0,1,2,3,4,7,0,0},
+	{5,7,0,0,0,0,0,0},
+	{0,5,7,0,0,0,0,0},
+	{1,5,7,0,0,0,0,0},
+	{0,1,5,7,0,0,0,0},
+	{2,5,7,0,0,0,0,0},
+	{0,2,5,7,0,0,0,0},
+	{1,2,5,7,0,0,0,0},
+	{0,1,2,5,7,0,0,0},
+	{3,5,7,0,0,0,0,0},
+	{0,3,5,7,0,0,0,0},
+	{1,3,5,7,0,0,0,0},
+	{0,1,3,5,7,0,0,0},
+	{2,3,5,7,0,0,0,0},
+	{0,2,3,5,7,0,0,0},
+	{1,2,3,5,7,0,0,0},
+	{0,1,2,3,5,7,0,0},
+	{4,5,7,0,0,0,0,0},
+	{0,4,5,7,0,0,0,0},
+	{1,4,5,7,0,0,0,0},
+	{0,1,4,5,7,0,0,0},
+	{2,4,5,7,0,0,0,0},
+	{0,2,4,5,7,0,0,0},
+	{1,2,4,5,7,0,0,0},
+	{0,1,2,4,5,7,0,0},
+	{3,4,5,7,0,0,0,0},
+	{0,3,4,5,7,0,0,0},
+	{1,3,4,5,7,0,0,0},
+	{0,1,3,4,5,7,0,0},
+	{2,3,4,5,7,0,0,0},
+	{0,2,3,4,5,7,0,0},
+	{1,2,3,4,5,7,0,0},
+	{0,1,2,3,4,5,7,0},
+	{6,7,0,0,0,0,0,0},
+	{0,6,7,0,0,0,0,0},
+	{1,6,7,0,0,0,0,0},
+	{0,1,6,7,0,0,0,0},
+	{2,6,7,0,0,0,0,0},
+	{0,2,6,7,0,0,0,0},
+	{1,2,6,7,0,0,0,0},
+	{0,1,2,6,7,0,0,0},
+	{3,6,7,0,0,0,0,0},
+	{0,3,6,7,0,0,0,0},
+	{1,3,6,7,0,0,0,0},
+	{0,1,3,6,7,0,0,0},
+	{2,3,6,7,0,0,0,0},
+	{0,2,3,6,7,0,0,0},
+	{1,2,3,6,7,0,0,0},
+	{0,1,2,3,6,7,0,0},
+	{4,6,7,0,0,0,0,0},
+	{0,4,6,7,0,0,0,0},
+	{1,4,6,7,0,0,0,0},
+	{0,1,4,6,7,0,0,0},
+	{2,4,6,7,0,0,0,0},
+	{0,2,4,6,7,0,0,0},
+	{1,2,4,6,7,0,0,0},
+	{0,1,2,4,6,7,0,0},
+	{3,4,6,7,0,0,0,0},
+	{0,3,4,6,7,0,0,0},
+	{1,3,4,6,7,0,0,0},
+	{0,1,3,4,6,7,0,0},
+	{2,3,4,6,7,0,0,0},
+	{0,2,3,4,6,7,0,0},
+	{1,2,3,4,6,7,0,0},
+	{0,1,2,3,4,6,7,0},
+	{5,6,7,0,0,0,0,0},
+	{0,5,6,7,0,0,0,0},
+	{1,5,6,7,0,0,0,0},
+	{0,1,5,6,7,0,0,0},
+	{2,5,6,7,0,0,0,0},
+	{0,2,5,6,7,0,0,0},
+	{1,2,5,6,7,0,0,0},
+	{0,1,2,5,6,7,0,0},
+	{3,5,6,7,0,0,0,0},
+	{0,3,5,6,7,0,0,0},
+	{1,3,5,6,7,0,0,0},
+	{0,1,3,5,6,7,0,0},
+	{2,3,5,6,7,0,0,0},
+	{0,2,3,5,6,7,0,0},
+	{1,2,3,5,6,7,0,0},
+	{0,1,2,3,5,6,7,0},
+	{4,5,6,7,0,0,0,0},
+	{0,4,5,6,7,0,0,0},
+	{1,4,5,6,7,0,0,0},
+	{0,1,4,5,6,7,0,0},
+	{2,4,5,6,7,0,0,0},
+	{0,2,4,5,6,7,0,0},
+	{1,2,4,5,6,7,0,0},
+	{0,1,2,4,5,6,7,0},
+	{3,4,5,6,7,0,0,0},
+	{0,3,4,5,6,7,0,0},
+	{1,3,4,5,6,7,0,0},
+	{0,1,3,4,5,6,7,0},
+	{2,3,4,5,6,7,0,0},
+	{0,2,3,4,5,6,7,0},
+	{1,2,3,4,5,6,7,0},
+	{0,1,2,3,4,5,6,7}
+};
+
+#ifdef LIBUTF16_AVX512
+
+/* AVX-512 engine of libutf16_utf8_count() */
+UTF_TARGET_AVX512
+static const utf8_char_t *utf8_count_avx512(
+	const utf8_char_t *s, const utf8_char_t *const se, size_t *const cont, size_t *const f4)
+{
+	size_t c = 0, f = 0;
+	while ((size_t)(se - s) > 64) {
+		const __m512i v0 = _mm512_loadu_si512(s);
+		const __mmask64 hi = _mm512_movepi8_mask(v0);
+		if (hi) {
+			__mmask64 st, ge_e0, ge_f0, r;
+			const unsigned n = utf8_avx512_check(v0, _mm512_loadu_si512(s + 1), 64, hi, &st, &ge_e0, &ge_f0);
+			if (!n)
+				break; /* invalid or incomplete utf8 character */
+			r = _bzhi_u64(~0ull, n); /* mask of bytes to process */
+			c += n - utf_popcnt64(st & r);
+			f += utf_popcnt64(ge_f0 & r);
+			s += n;
+		}
+		else
+			s += 64;
+	}
+	*cont += c;
+	*f4 += f;
+	return s;
+}
+
+#endif /* LIBUTF16_AVX512 */
+
+/* AVX2 engine of libutf16_utf8_count() */
+UTF_TARGET_AVX2
+static const utf8_char_t *utf8_count_avx2(
+	const utf8_char_t *s, const utf8_char_t *const se, size_t *const cont, size_t *const f4)
+{
+	size_t c = 0, f = 0;
+	while ((size_t)(se - s) >= 64) {
+		const __m256i v0 = _mm256_loadu_si256((const __m256i*)s);
+		const unsigned hi = (unsigned)_mm256_movemask_epi8(v0);
+		if (hi) {
+			unsigned cm, ge_e0, ge_f0, r;
+			const unsigned n = utf8_avx2_check(v0, _mm256_loadu_si256((const __m256i*)(s + 1)), hi, &cm, &ge_e0, &ge_f0);
+			if (!n)
+				break; /* invalid or incomplete utf8 character */
+			r = 0xFFFFFFFFu >> (32 - n); /* mask of bytes to process */
+			c += utf_popcnt32(cm & r);
+			f += utf_popcnt32(ge_f0 & r);
+			s += n;
+		}
+		else
+			s += 32;
+	}
+	*cont += c;
+	*f4 += f;
+	return s;
+}
+
+const utf8_char_t *libutf16_utf8_count(
+	const utf8_char_t *const s, const utf8_char_t *const se, size_t *const cont, size_t *const f4)
+{
+#ifdef LIBUTF16_AVX512
+	if (libutf16_cpu_features() & UTF_CPU_AVX512)
+		return utf8_count_avx512(s, se, cont, f4);
+#endif
+	if (libutf16_cpu_features() & UTF_CPU_AVX2)
+		return utf8_count_avx2(s, se, cont, f4);
+	return s;
+}
+
+/* size of a window, in which the terminating 0 is searched before validating its part by the engine */
+#define UTF8_COUNT_Z_WINDOW 4096
+
+const utf8_char_t *libutf16_utf8_count_z(
+	const utf8_char_t *s, size_t *const cont, size_t *const f4)
+{
+	const utf8_char_t *z = s;
+	if (!(libutf16_cpu_features() & (UTF_CPU_AVX2 | UTF_CPU_AVX512)))
+		return s;
+	for (;;) {
+		const utf8_char_t *const p = (const utf8_char_t*)memchr(z, 0, UTF8_COUNT_Z_WINDOW);
+		z = p ? p : z + UTF8_COUNT_Z_WINDOW;
+		s = libutf16_utf8_count(s, z, cont, f4);
+		if (p || (size_t)(z - s) > 64)
+			return s; /* 0 was found or the engine has stopped before invalid utf8 character */
+	}
+}
+
+#endif /* LIBUTF16_AVX2 */
+
+int libutf16_engine(void)
+{
+#ifdef LIBUTF16_AVX2
+	const unsigned f = libutf16_cpu_features();
+	return
+		(f & UTF_CPU_AVX512) ? LIBUTF16_ENGINE_AVX512 :
+		(f & UTF_CPU_AVX2) ? LIBUTF16_ENGINE_AVX2 :
+		LIBUTF16_ENGINE_SCALAR;
+#else
+	return LIBUTF16_ENGINE_SCALAR;
+#endif
+}
+
+int libutf16_set_engine(const int engine)
+{
+#ifdef LIBUTF16_AVX2
+	libutf16_engine_limit = engine < 0 ? -1 : engine;
+	(void)libutf16_cpu_detect();
+#else
+	(void)engine;
+#endif
+	return libutf16_engine();
+}
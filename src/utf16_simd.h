@@ -0,0 +1,428 @@
+#ifndef UTF16_SIMD_H_INCLUDED
+#define UTF16_SIMD_H_INCLUDED
+
+/**********************************************************************************
+* SIMD engines support for utf8/utf16/utf32 conversions
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf16_simd.h */
+
+/* SIMD engines are compiled into the same objects as the scalar code (using per-function
+  target attributes, so no special compiler flags are needed) and are selected at run time,
+  after checking cpu features.
+  To build scalar-only library, define LIBUTF16_NO_SIMD. */
+
+#ifndef LIBUTF16_NO_SIMD
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)))
+#define LIBUTF16_AVX2
+#define UTF_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#elif defined(_MSC_VER) && (_MSC_VER >= 1800)
+#define LIBUTF16_AVX2
+#define UTF_TARGET_AVX2
+#endif
+#endif
+/* AVX-512 engines (F, BW, VL, VBMI, VBMI2) operate on 64-bit masks, so are supported only on x86_64 */
+#if defined(LIBUTF16_AVX2) && (defined(__x86_64__) || defined(_M_X64))
+#if (defined(__clang__) && __clang_major__ >= 8) || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 8)
+#define LIBUTF16_AVX512
+#define UTF_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,avx512vbmi,avx512vbmi2,bmi,bmi2,popcnt")))
+#elif defined(_MSC_VER) && !defined(__clang__) && (_MSC_VER >= 1920)
+#define LIBUTF16_AVX512
+#define UTF_TARGET_AVX512
+#endif
+#endif
+#endif /* !LIBUTF16_NO_SIMD */
+
+/* vector loads of 0-terminated strings and short-string kernels may read bytes beyond the end of a string
+  (but never beyond its memory page), functions doing so are excluded from AddressSanitizer checks,
+  so that programs using the library may be built with -fsanitize=address */
+#if defined(__clang__) || defined(__GNUC__)
+#define UTF_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#elif defined(_MSC_VER) && (_MSC_VER >= 1928)
+#define UTF_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#else
+#define UTF_NO_SANITIZE_ADDRESS
+#endif
+
+#ifdef LIBUTF16_AVX2
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> /* for __popcnt(), _BitScanReverse(), _BitScanForward() */
+#define utf_popcnt32(x)   __popcnt(x)
+static __forceinline unsigned utf_bsr32(const unsigned x/*!=0*/)
+{
+	unsigned long i;
+	_BitScanReverse(&i, x);
+	return (unsigned)i;
+}
+static __forceinline unsigned utf_bsf32(const unsigned x/*!=0*/)
+{
+	unsigned long i;
+	_BitScanForward(&i, x);
+	return (unsigned)i;
+}
+#else
+#define utf_popcnt32(x)   ((unsigned)__builtin_popcount(x))
+#define utf_bsr32(x)      (31u - (unsigned)__builtin_clz(x)) /* x != 0 */
+#define utf_bsf32(x)      ((unsigned)__builtin_ctz(x))       /* x != 0 */
+#endif
+
+/* cpu features, as detected by libutf16_cpu_detect() */
+#define UTF_CPU_DETECTED  1u /* features were detected */
+#define UTF_CPU_AVX2      2u /* AVX2 + POPCNT, enabled by OS */
+#define UTF_CPU_AVX512    4u /* AVX-512 F/BW/VL/VBMI/VBMI2 + BMI1/BMI2, enabled by OS */
+
+/* cached result of libutf16_cpu_detect(), 0 - not detected yet */
+extern unsigned libutf16_cpu_features_;
+
+/* detect features of the cpu we are running on, cache and return them */
+unsigned libutf16_cpu_detect(void);
+
+static inline unsigned libutf16_cpu_features(void)
+{
+	const unsigned f = libutf16_cpu_features_;
+	return f ? f : libutf16_cpu_detect();
+}
+
+/* left-packing shuffle masks for _mm_shuffle_epi8():
+  for each 8-bit mask of selected 16-bit lanes, moves selected lanes to the beginning of the vector */
+extern const unsigned char libutf16_pack16_shuf[256][16];
+
+/* left-packing permutation indices for _mm256_permutevar8x32_epi32() (zero-extended to 32 bits):
+  for each 8-bit mask of selected 32-bit lanes, moves selected lanes to the beginning of the vector */
+extern const unsigned char libutf16_pack32_perm[256][8];
+
+/* packing shuffle masks for _mm_shuffle_epi8() to form utf8 characters from four 32-bit lanes,
+  each lane holds 1-3 bytes of utf8 character, index - (m1 | m2 << 4), where
+  m1 - 4-bit mask of lanes with characters >= 0x80, m2 - 4-bit mask of lanes with characters >= 0x800 */
+extern const unsigned char libutf16_utf8_pack32_shuf[256][16];
+
+/* packing shuffle masks for _mm_shuffle_epi8() to form utf8 characters from four 32-bit lanes,
+  each lane holds 1-4 bytes of utf8 character, index - lengths of characters minus one, 2 bits per lane */
+extern const unsigned char libutf16_utf8_pack32_len_shuf[256][16];
+
+/* size-only pass of utf8 -> utf16/utf32 conversions: validate utf8_char_t's without converting them,
+  using the best engine supported by the cpu (does nothing if there is none), while more than 64 of them remain:
+ - stops before a block containing invalid utf8 character, so the scalar code reports it at exact position,
+ - leaves at least one utf8_char_t, the last validated utf8 character is complete.
+ returns pointer beyond the last validated utf8_char_t, adds to (*cont) the number of continuation bytes
+ 10xxxxxx and to (*f4) the number of 4-byte utf8 characters among the validated utf8_char_t's */
+const utf8_char_t *libutf16_utf8_count(
+	const utf8_char_t *s, const utf8_char_t *se, size_t *cont, size_t *f4);
+
+/* same as libutf16_utf8_count(), but for 0-terminated utf8 string: validates its part before the terminating 0 */
+const utf8_char_t *libutf16_utf8_count_z(
+	const utf8_char_t *s, size_t *cont, size_t *f4);
+
+/* validate a block of 32 utf8_char_t's:
+  v0 - the block, v1 - the block shifted by one utf8_char_t, hi - non-zero bit mask of bytes >= 0x80 in v0,
+  bytes following the block must be readable, as 4-byte characters started in the block are checked entirely.
+  Returns number of utf8_char_t's in complete valid utf8 characters at the beginning of the block,
+  0 - the block starts with invalid or incomplete utf8 character.
+  Also returns bit masks of the block bytes: (*cont) - continuation bytes 10xxxxxx,
+  (*ge_e0) - starting bytes of 3- and 4-byte characters, (*ge_f0) - starting bytes of 4-byte characters */
+UTF_TARGET_AVX2
+static inline unsigned utf8_avx2_check(const __m256i v0, const __m256i v1, const unsigned hi,
+	unsigned *const cont, unsigned *const ge_e0, unsigned *const ge_f0)
+{
+	const unsigned c = (unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8((char)0xC0), v0));
+	const unsigned ge_c0 = hi & ~c;
+	const unsigned e0 = hi & (unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(v0, _mm256_set1_epi8((char)0xDF)));
+	const unsigned f0 = hi & (unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(v0, _mm256_set1_epi8((char)0xEF)));
+	unsigned p, n, r;
+	*cont = c;
+	*ge_e0 = e0;
+	*ge_f0 = f0;
+	if (!~c)
+		return 0; /* no starting bytes of utf8 characters */
+	/* position of the last starting byte, process complete characters before it */
+	p = utf_bsr32(~c);
+	n = p + !((hi >> p) & 1); /* complete one-byte character may be processed too */
+	if (!n)
+		return 0; /* single incomplete character */
+	/* each utf8 character must have exactly the number of continuation bytes encoded in its first byte */
+	if (((c ^ ((ge_c0 << 1) | (e0 << 2) | (f0 << 3))) << (31 - p)))
+		return 0;
+	r = 0xFFFFFFFFu >> (32 - n); /* mask of bytes to process */
+	/* not expecting overlong 1100000x or too big 11110101-11111111 */
+	if (((ge_c0 & ~(unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(v0, _mm256_set1_epi8((char)0xC1)))) |
+		(hi & (unsigned)_mm256_movemask_epi8(_mm256_cmpgt_epi8(v0, _mm256_set1_epi8((char)0xF4))))) & r)
+	{
+		return 0;
+	}
+	if (e0 & r) {
+		/* check second bytes: overlong 0xE0 0x80-0x9F, surrogate 0xED 0xA0-0xBF,
+		  overlong 0xF0 0x80-0x8F, too big 0xF4 0x90-0xBF */
+		const __m256i lt_a0 = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)0xA0), v1);
+		const __m256i lt_90 = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)0x90), v1);
+		const __m256i bad = _mm256_or_si256(
+			_mm256_or_si256(
+				_mm256_and_si256(_mm256_cmpeq_epi8(v0, _mm256_set1_epi8((char)0xE0)), lt_a0),
+				_mm256_andnot_si256(lt_a0, _mm256_cmpeq_epi8(v0, _mm256_set1_epi8((char)0xED)))),
+			_mm256_or_si256(
+				_mm256_and_si256(_mm256_cmpeq_epi8(v0, _mm256_set1_epi8((char)0xF0)), lt_90),
+				_mm256_andnot_si256(lt_90, _mm256_cmpeq_epi8(v0, _mm256_set1_epi8((char)0xF4)))));
+		if ((unsigned)_mm256_movemask_epi8(bad) & r)
+			return 0;
+	}
+	return n;
+}
+
+/* validate a block of 16 utf16_char_t's v (in native byte order), for the size-only pass:
+  each high surrogate must be followed by a low one and each low surrogate must follow a high one,
+  (*hc) - on input: 3 if the previous block ends with a high surrogate, else 0, on output - the same for this block.
+  Returns 0 if the block contains invalid utf16 character, else non-zero and (*lo) - bit mask of
+  low surrogates in the block, 2 bits per utf16_char_t */
+UTF_TARGET_AVX2
+static inline int utf16_avx2_check(const __m256i v, unsigned *const hc, unsigned *const lo)
+{
+	const __m256i x = _mm256_and_si256(v, _mm256_set1_epi16((short)0xFC00));
+	const unsigned h = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi16(x, _mm256_set1_epi16((short)0xD800)));
+	const unsigned l = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi16(x, _mm256_set1_epi16((short)0xDC00)));
+	if (((h << 2) | *hc) ^ l)
+		return 0;
+	*hc = h >> 30;
+	*lo = l;
+	return 1;
+}
+
+/* validate 8 utf32_char_t's c (in native byte order), for the size-only pass:
+  returns non-zero if all of them are unicode code points <= 0x10FFFF and are not surrogates */
+UTF_TARGET_AVX2
+static inline int utf32_avx2_valid(const __m256i c)
+{
+	const __m256i bad = _mm256_or_si256(
+		_mm256_xor_si256(_mm256_min_epu32(c, _mm256_set1_epi32(0x10FFFF)), c),
+		_mm256_cmpeq_epi32(_mm256_and_si256(c, _mm256_set1_epi32((int)0xFFFFF800)), _mm256_set1_epi32(0xD800)));
+	return _mm256_testz_si256(bad, bad);
+}
+
+/* memory is accessible by pages, so reading a 0-terminated string up to the end of the page containing
+  its current position is always safe (AVX-512 masked loads also do not fault on masked-out bytes) */
+#define UTF_PAGE_SIZE 4096
+
+/* find the first zero utf16_char_t (w == 2) or utf32_char_t (w == 4) among n ones starting at s (may be unaligned),
+  vector loads do not cross page boundaries, so may read beyond the terminating 0 only within its page,
+  returns index of the found zero character or n, if there is no zero one */
+UTF_TARGET_AVX2 UTF_NO_SANITIZE_ADDRESS
+static inline size_t utf_avx2_find0(const void *const s, const size_t n, const unsigned w)
+{
+	const unsigned char *z = (const unsigned char*)s;
+	const unsigned char *const end = z + n*w;
+	while (z < end) {
+		if (((size_t)z & (UTF_PAGE_SIZE - 1)) <= UTF_PAGE_SIZE - 32) {
+			const __m256i v = _mm256_loadu_si256((const __m256i*)z);
+			const unsigned m = (unsigned)_mm256_movemask_epi8(2 == w ?
+				_mm256_cmpeq_epi16(v, _mm256_setzero_si256()) : _mm256_cmpeq_epi32(v, _mm256_setzero_si256()));
+			if (m) {
+				z += utf_bsf32(m);
+				break;
+			}
+			z += 32;
+		}
+		else {
+			/* a vector would cross the page boundary, check characters one by one */
+			if (!(z[0] | z[1] | (2 == w ? 0 : z[2] | z[3])))
+				break;
+			z += w;
+		}
+	}
+	return z < end ? (size_t)(z - (const unsigned char*)s)/w : n;
+}
+
+/* short-string kernels: load n <= 32 bytes starting at s (may be unaligned), zeroing the rest of the vector,
+  the vector load is done only if it does not cross the page boundary, so never reads inaccessible memory */
+/* note: #include <memory.h> for memcpy() */
+UTF_TARGET_AVX2 UTF_NO_SANITIZE_ADDRESS
+static inline __m256i utf_avx2_load_short(const void *const s, const unsigned n/*<=32*/)
+{
+	const __m256i m = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)n), _mm256_setr_epi8(
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+		16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31));
+	if (((size_t)s & (UTF_PAGE_SIZE - 1)) <= UTF_PAGE_SIZE - 32)
+		return _mm256_and_si256(_mm256_loadu_si256((const __m256i*)s), m);
+	{
+		/* rare case: bytes are at the end of the page */
+		unsigned char t[32] = {0};
+		memcpy(t, s, n);
+		return _mm256_loadu_si256((const __m256i*)t);
+	}
+}
+
+/* short-string kernels: store first n <= 32 bytes of v to d (may be unaligned), bytes beyond d[n-1] are not touched */
+UTF_TARGET_AVX2
+static inline void utf_avx2_store_short(void *const d, const __m256i v, const unsigned n/*<=32*/)
+{
+	_mm256_maskstore_epi32((int*)d, _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(n >> 2)),
+		_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)), v);
+	if (n & 3) {
+		/* move the dword containing the tail bytes to the lowest lane */
+		unsigned char *p = (unsigned char*)d + (n & ~3u);
+		unsigned x = (unsigned)_mm256_cvtsi256_si32(
+			_mm256_permutevar8x32_epi32(v, _mm256_set1_epi32((int)(n >> 2))));
+		if (n & 2) {
+			*p++ = (unsigned char)x;
+			*p++ = (unsigned char)(x >> 8);
+			x >>= 16;
+		}
+		if (n & 1)
+			*p = (unsigned char)x;
+	}
+}
+
+/* short-string kernels: shift bytes of v by k (imm, 0 < k < 16) positions towards the beginning, filling by zeros */
+#define utf_avx2_shift_short(v, k) _mm256_alignr_epi8(_mm256_permute2x128_si256(v, v, 0x81), v, k)
+
+#endif /* LIBUTF16_AVX2 */
+
+#ifdef LIBUTF16_AVX512
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define utf_popcnt64(x)   ((unsigned)__popcnt64(x))
+static __forceinline unsigned utf_bsr64(const unsigned __int64 x/*!=0*/)
+{
+	unsigned long i;
+	_BitScanReverse64(&i, x);
+	return (unsigned)i;
+}
+static __forceinline unsigned utf_bsf64(const unsigned __int64 x/*!=0*/)
+{
+	unsigned long i;
+	_BitScanForward64(&i, x);
+	return (unsigned)i;
+}
+#else
+#define utf_popcnt64(x)   ((unsigned)__builtin_popcountll(x))
+#define utf_bsr64(x)      (63u - (unsigned)__builtin_clzll(x)) /* x != 0 */
+#define utf_bsf64(x)      ((unsigned)__builtin_ctzll(x))       /* x != 0 */
+#endif
+
+/* for engine parts that must be inlined into each of their callers */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define UTF_FORCE_INLINE  __forceinline
+#else
+#define UTF_FORCE_INLINE  inline __attribute__((always_inline))
+#endif
+
+/* validate a block of l (1..64) utf8_char_t's:
+  v0 - the block, bytes of v0 beyond the l-th must be zero, v1 - v0 shifted by one utf8_char_t
+  (its last byte is not checked), hi - non-zero bit mask of bytes >= 0x80 in v0.
+  If l < 64, the input ends with the block, so the last utf8 character in it must be complete,
+  else the last non-one-byte utf8 character is left for the next block.
+  Returns number of utf8_char_t's in complete valid utf8 characters at the beginning of the block,
+  0 - the block starts with invalid or incomplete utf8 character.
+  Also returns bit masks of the block bytes: (*start) - starting bytes of utf8 characters,
+  (*ge_e0) - starting bytes of 3- and 4-byte characters, (*ge_f0) - starting bytes of 4-byte characters */
+UTF_TARGET_AVX512
+static inline unsigned utf8_avx512_check(const __m512i v0, const __m512i v1, const unsigned l, const __mmask64 hi,
+	__mmask64 *const start, __mmask64 *const ge_e0, __mmask64 *const ge_f0)
+{
+	const __mmask64 ge_c0 = _mm512_cmpge_epu8_mask(v0, _mm512_set1_epi8((char)0xC0));
+	const __mmask64 e0 = _mm512_cmpge_epu8_mask(v0, _mm512_set1_epi8((char)0xE0));
+	const __mmask64 f0 = _mm512_cmpge_epu8_mask(v0, _mm512_set1_epi8((char)0xF0));
+	const __mmask64 c = hi & ~ge_c0;
+	const __mmask64 st = ~c & _bzhi_u64(~0ull, l);
+	unsigned p, n;
+	__mmask64 r;
+	*start = st;
+	*ge_e0 = e0;
+	*ge_f0 = f0;
+	if (l < 64)
+		p = n = l; /* (v0 >> 8*l) & 0xFF == 0 - must not be a continuation byte */
+	else {
+		if (!st)
+			return 0; /* no starting bytes of utf8 characters */
+		/* position of the last starting byte, process complete characters before it */
+		p = utf_bsr64(st);
+		n = p + !((hi >> p) & 1); /* complete one-byte character may be processed too */
+		if (!n)
+			return 0; /* single incomplete character */
+	}
+	/* each utf8 character must have exactly the number of continuation bytes encoded in its first byte */
+	if ((c ^ ((ge_c0 << 1) | (e0 << 2) | (f0 << 3))) & _bzhi_u64(~0ull, p + 1))
+		return 0;
+	r = _bzhi_u64(~0ull, n); /* mask of bytes to process */
+	/* not expecting overlong 1100000x or too big 11110101-11111111 */
+	if ((_mm512_mask_cmplt_epu8_mask(ge_c0, v0, _mm512_set1_epi8((char)0xC2)) |
+		_mm512_cmpgt_epu8_mask(v0, _mm512_set1_epi8((char)0xF4))) & r)
+	{
+		return 0;
+	}
+	if (e0 & r) {
+		/* check second bytes: overlong 0xE0 0x80-0x9F, surrogate 0xED 0xA0-0xBF,
+		  overlong 0xF0 0x80-0x8F, too big 0xF4 0x90-0xBF */
+		const __mmask64 lt_a0 = _mm512_cmplt_epu8_mask(v1, _mm512_set1_epi8((char)0xA0));
+		const __mmask64 lt_90 = _mm512_cmplt_epu8_mask(v1, _mm512_set1_epi8((char)0x90));
+		const __mmask64 bad =
+			_mm512_mask_cmpeq_epi8_mask(lt_a0, v0, _mm512_set1_epi8((char)0xE0)) |
+			_mm512_mask_cmpeq_epi8_mask(~lt_a0, v0, _mm512_set1_epi8((char)0xED)) |
+			_mm512_mask_cmpeq_epi8_mask(lt_90, v0, _mm512_set1_epi8((char)0xF0)) |
+			_mm512_mask_cmpeq_epi8_mask(~lt_90, v0, _mm512_set1_epi8((char)0xF4));
+		if (bad & r)
+			return 0;
+	}
+	return n;
+}
+
+/* encode 16 valid unicode code points in 32-bit lanes of c to utf8:
+  each lane gets 1-4 bytes of the encoded character (the unused high bytes are zero),
+  (*keep) - bit mask of bytes of the encoded characters in lanes selected by k,
+  to be left-packed by _mm512_maskz_compress_epi8() */
+UTF_TARGET_AVX512
+static inline __m512i utf8_avx512_encode(const __m512i c, const __mmask16 k, __mmask64 *const keep)
+{
+	const __mmask16 g1 = _mm512_cmpgt_epu32_mask(c, _mm512_set1_epi32(0x7F));
+	const __mmask16 g2 = _mm512_cmpgt_epu32_mask(c, _mm512_set1_epi32(0x7FF));
+	const __mmask16 g3 = _mm512_cmpgt_epu32_mask(c, _mm512_set1_epi32(0xFFFF));
+	const __m512i m = _mm512_set1_epi32(0x3F);
+	const __m512i t = _mm512_or_si512(_mm512_and_si512(c, m), _mm512_set1_epi32(0x80));
+	const __m512i t6 = _mm512_or_si512(_mm512_and_si512(_mm512_srli_epi32(c, 6), m), _mm512_set1_epi32(0x80));
+	/* 00000aaaaabbbbbb -> 110aaaaa 10bbbbbb */
+	__m512i v = _mm512_mask_or_epi32(c, g1,
+		_mm512_or_si512(_mm512_srli_epi32(c, 6), _mm512_set1_epi32(0xC0)), _mm512_slli_epi32(t, 8));
+	if (g2) {
+		/* aaaabbbbbbcccccc -> 1110aaaa 10bbbbbb 10cccccc */
+		v = _mm512_mask_or_epi32(v, g2,
+			_mm512_or_si512(_mm512_srli_epi32(c, 12), _mm512_set1_epi32(0xE0)),
+			_mm512_or_si512(_mm512_slli_epi32(t6, 8), _mm512_slli_epi32(t, 16)));
+		if (g3) {
+			/* aaabbbbbbccccccdddddd -> 11110aaa 10bbbbbb 10cccccc 10dddddd */
+			v = _mm512_mask_or_epi32(v, g3,
+				_mm512_or_si512(
+					_mm512_or_si512(_mm512_srli_epi32(c, 18), _mm512_set1_epi32(0xF0)),
+					_mm512_slli_epi32(_mm512_or_si512(
+						_mm512_and_si512(_mm512_srli_epi32(c, 12), m), _mm512_set1_epi32(0x80)), 8)),
+				_mm512_or_si512(_mm512_slli_epi32(t6, 16), _mm512_slli_epi32(t, 24)));
+		}
+	}
+	/* the first byte of a character may be zero, the following ones - not */
+	*keep = _mm512_test_epi8_mask(_mm512_maskz_or_epi32(k, v, _mm512_set1_epi32(1)), _mm512_set1_epi8(-1));
+	return v;
+}
+
+/* load 64 bytes of 0-terminated string of w-byte characters (w == 1, 2 or 4) starting at s (may be unaligned),
+  never reading memory beyond the page containing the terminating 0: if the vector crosses the page boundary
+  and there is a zero character before it, bytes beyond the boundary are not loaded (they are zero) */
+UTF_TARGET_AVX512 UTF_NO_SANITIZE_ADDRESS
+static inline __m512i utf_avx512_load_z(const void *const s, const unsigned w)
+{
+	const unsigned p = (unsigned)(UTF_PAGE_SIZE - ((size_t)s & (UTF_PAGE_SIZE - 1))); /* bytes up to the end of the page */
+	if (p < 64) {
+		const __m512i v = _mm512_maskz_loadu_epi8(_bzhi_u64(~0ull, p), s);
+		const __mmask64 z = 1 == w ? _mm512_testn_epi8_mask(v, v) :
+			2 == w ? (__mmask64)_mm512_testn_epi16_mask(v, v) : (__mmask64)_mm512_testn_epi32_mask(v, v);
+		/* if there is no 0 up to the end of the page, the next page is readable */
+		if (z & _bzhi_u64(~0ull, p/w))
+			return v;
+	}
+	return _mm512_loadu_si512(s);
+}
+
+#endif /* LIBUTF16_AVX512 */
+
+#endif /* UTF16_SIMD_H_INCLUDED */
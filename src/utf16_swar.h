@@ -0,0 +1,84 @@
+#ifndef UTF16_SWAR_H_INCLUDED
+#define UTF16_SWAR_H_INCLUDED
+
+/**********************************************************************************
+* Word-at-a-time (SWAR) helpers for utf8/utf16/utf32 conversions
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf16_swar.h */
+
+/* portable fast paths of scalar loops for runs of ascii (or, for utf16 <-> utf32 conversions, BMP) characters:
+  8 utf8_char_t's, 4 utf16_char_t's or 2 utf32_char_t's are checked at once by loading them into a 64-bit word.
+  Note: utf16/utf32 characters are checked in the byte order of the buffer, so masks do not depend on
+  the endianness of the platform, only on the byte swapping. */
+
+#ifdef _MSC_VER
+typedef unsigned __int64 utf_word64_t;
+#else
+#include <stdint.h> /* for uint64_t */
+typedef uint64_t utf_word64_t;
+#endif
+
+/* note: #include <memory.h> for memcpy() */
+static inline utf_word64_t utf_load64(const void *const p)
+{
+	utf_word64_t w;
+	memcpy(&w, p, sizeof(w));
+	return w;
+}
+
+/* bits, which must be zero in ascii utf8_char_t's */
+#define UTF8_SWAR_NOT_ASCII   0x8080808080808080ull
+
+/* bits, which must be zero in ascii utf16_char_t's */
+#ifdef SWAP_UTF16
+#define UTF16_SWAR_NOT_ASCII  0x80FF80FF80FF80FFull
+#else
+#define UTF16_SWAR_NOT_ASCII  0xFF80FF80FF80FF80ull
+#endif
+
+/* bits, which must be zero in ascii utf32_char_t's */
+#ifdef SWAP_UTF32
+#define UTF32_SWAR_NOT_ASCII  0x80FFFFFF80FFFFFFull
+#else
+#define UTF32_SWAR_NOT_ASCII  0xFFFFFF80FFFFFF80ull
+#endif
+
+/* masks to check 16-bit lanes for surrogates: (c & mask) == value */
+#ifdef SWAP_UTF16
+#define UTF16_SWAR_SURR_MASK  0x00F800F800F800F8ull
+#define UTF16_SWAR_SURR       0x00D800D800D800D8ull
+#else
+#define UTF16_SWAR_SURR_MASK  0xF800F800F800F800ull
+#define UTF16_SWAR_SURR       0xD800D800D800D800ull
+#endif
+
+/* masks to check 32-bit lanes for characters out of BMP and for surrogates */
+#ifdef SWAP_UTF32
+#define UTF32_SWAR_NOT_BMP    0x0000FFFF0000FFFFull
+#define UTF32_SWAR_SURR_MASK  0x00F8FFFF00F8FFFFull
+#define UTF32_SWAR_SURR       0x00D8000000D80000ull
+#else
+#define UTF32_SWAR_NOT_BMP    0xFFFF0000FFFF0000ull
+#define UTF32_SWAR_SURR_MASK  0xFFFFF800FFFFF800ull
+#define UTF32_SWAR_SURR       0x0000D8000000D800ull
+#endif
+
+/* non-zero if any of 4 utf16_char_t's in the word is a surrogate */
+static inline int utf16_swar_has_surrogate(const utf_word64_t w)
+{
+	const utf_word64_t x = (w & UTF16_SWAR_SURR_MASK) ^ UTF16_SWAR_SURR;
+	return 0 != ((x - 0x0001000100010001ull) & ~x & 0x8000800080008000ull); /* some 16-bit lane of x is zero */
+}
+
+/* non-zero if any of 2 utf32_char_t's in the word is not from BMP or is a surrogate */
+static inline int utf32_swar_not_bmp(const utf_word64_t w)
+{
+	const utf_word64_t x = (w & UTF32_SWAR_SURR_MASK) ^ UTF32_SWAR_SURR;
+	return 0 != ((w & UTF32_SWAR_NOT_BMP) |
+		((x - 0x0000000100000001ull) & ~x & 0x8000000080000000ull)); /* some 32-bit lane of x is zero */
+}
+
+#endif /* UTF16_SWAR_H_INCLUDED */
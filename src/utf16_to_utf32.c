@@ -22,6 +22,8 @@
 #include "libutf16/utf16_swap.h"
 
 #include "utf16_internal.h"
+#include "utf16_simd.h"
+#include "utf16_swar.h"
 
 #ifdef _MSC_VER
 #pragma warning(disable:5045) /* Compiler will insert Spectre mitigation for memory load if /Qspectre switch specified */
@@ -43,6 +45,213 @@
 #define UTF_FORM_NAME1(fu, fx, tu, tx, suffix)  UTF_FORM_NAME2(fu, fx, tu, tx, suffix)
 #define UTF_FORM_NAME(suffix)                   UTF_FORM_NAME1(UTF_GET_U, UTF16_X, UTF_PUT_U, UTF32_X, suffix)
 
+/* kind of tokens of validated strings, filled and accepted by this form of conversion */
+#define UTF_TOKEN_KIND (UTF_TOKEN_UTF16_TO_UTF32 | UTF16_TOKEN_X | UTF_TOKEN_GET_U)
+
+#ifdef LIBUTF16_AVX2
+#define UTF16_TO_UTF32_AVX2
+
+/* load 16 utf16_char_t's */
+UTF_TARGET_AVX2
+static inline __m256i utf16_to_utf32_avx2_load(const UTF16_CHAR_T *const s)
+{
+#ifdef SWAP_UTF16
+	return _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)s), _mm256_setr_epi8(
+		1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+#else
+	return _mm256_loadu_si256((const __m256i*)s);
+#endif
+}
+
+/* store 8 utf32_char_t's */
+UTF_TARGET_AVX2
+static inline void utf16_to_utf32_avx2_store(UTF32_CHAR_T *const d, const __m256i v)
+{
+#ifdef SWAP_UTF32
+	_mm256_storeu_si256((__m256i*)d, _mm256_shuffle_epi8(v, _mm256_setr_epi8(
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)));
+#else
+	_mm256_storeu_si256((__m256i*)d, v);
+#endif
+}
+
+/* combine 8 utf16_char_t's with surrogate pairs and store resulting utf32_char_t's:
+  c - zero-extended utf16_char_t's, c1 - the same shifted by one utf16_char_t, h - lanes of high surrogates,
+  k - 8-bit mask of lanes to store (not low surrogates), returns pointer beyond stored characters,
+  may store up to 8 garbage utf32_char_t's after it */
+UTF_TARGET_AVX2
+static inline UTF32_CHAR_T *utf16_to_utf32_avx2_pairs(
+	UTF32_CHAR_T *const d, const __m256i c, const __m256i c1, const __m256i h, const unsigned k)
+{
+	/* 110110xxyyyyyyyy0000000000
+	  +          110111aabbbbbbbb
+	  -11011000001101110000000000
+	  ===========================
+	         xxyyyyyyyyaabbbbbbbb
+	  +         10000000000000000 */
+	const __m256i v = _mm256_blendv_epi8(c,
+		_mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(c, 10), c1), _mm256_set1_epi32(-0x360DC00 + 0x10000)), h);
+	utf16_to_utf32_avx2_store(d, _mm256_permutevar8x32_epi32(v,
+		_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)libutf16_pack32_perm[k]))));
+	return d + utf_popcnt32(k);
+}
+
+/* AVX2 engine: validate and convert blocks of 16 utf16_char_t's,
+  while at least 32 utf16_char_t's remain in the input and there is a space for more than 16 utf32_char_t's:
+ - blocks without surrogates are just zero-extended,
+ - in other blocks, high surrogates are combined with following low ones, which are then dropped,
+  a pair split by the end of the block is converted with the next block,
+ - stops at invalid utf16 character, so the scalar code reports it at exact position,
+ - may store up to 8 garbage utf32_char_t's beyond the (*b), they are overwritten while converting
+  remaining (at least 16) utf16_char_t's.
+ returns pointer beyond the last converted utf16_char_t, updates (*b) */
+UTF_TARGET_AVX2
+static const UTF16_CHAR_T *utf16_to_utf32_avx2(
+	const UTF16_CHAR_T *s, const UTF16_CHAR_T *const se,
+	UTF32_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF32_CHAR_T *const e)
+{
+	UTF32_CHAR_T *d = *b;
+	while ((size_t)(se - s) >= 32 && (size_t)(e - (const UTF32_CHAR_T*)d) > 16) {
+		const __m256i v = utf16_to_utf32_avx2_load(s);
+		const __m256i hv = _mm256_cmpeq_epi16(_mm256_and_si256(v, _mm256_set1_epi16((short)0xFC00)), _mm256_set1_epi16((short)0xD800));
+		const __m256i lv = _mm256_cmpeq_epi16(_mm256_and_si256(v, _mm256_set1_epi16((short)0xFC00)), _mm256_set1_epi16((short)0xDC00));
+		/* 2 bits per high/low surrogate */
+		const unsigned hs = (unsigned)_mm256_movemask_epi8(hv);
+		const unsigned ls = (unsigned)_mm256_movemask_epi8(lv);
+		if (!(hs | ls)) {
+			utf16_to_utf32_avx2_store(d, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v)));
+			utf16_to_utf32_avx2_store(d + 8, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1)));
+			s += 16;
+			d += 16;
+		}
+		else {
+			/* each high surrogate must be followed by a low one, the last high surrogate - by the next block */
+			const unsigned bad = ls ^ (hs << 2);
+			unsigned n = 16 - (hs >> 31), r;
+			if (bad) {
+				const unsigned p = utf_bsf32(bad) / 2;
+				/* do not separate a high surrogate from its (missing) low one */
+				if (p <= n)
+					n = p - (p && ((hs >> (2*p - 2)) & 1));
+			}
+			if (!n)
+				break; /* invalid utf16 surrogate pair */
+			{
+				const __m256i v1 = utf16_to_utf32_avx2_load(s + 1);
+				/* bit masks of low surrogates: lanes 0-7 - in bits 0-7, lanes 8-15 - in bits 16-23 */
+				r = (unsigned)_mm256_movemask_epi8(_mm256_packs_epi16(lv, _mm256_setzero_si256()));
+				/* mask of characters to store: all except low surrogates */
+				r = ~((r & 0xFF) | ((r >> 8) & 0xFF00)) & ((1u << n) - 1);
+				d = utf16_to_utf32_avx2_pairs(d,
+					_mm256_cvtepu16_epi32(_mm256_castsi256_si128(v)),
+					_mm256_cvtepu16_epi32(_mm256_castsi256_si128(v1)),
+					_mm256_cvtepi16_epi32(_mm256_castsi256_si128(hv)), r & 0xFF);
+				if (n > 8) {
+					d = utf16_to_utf32_avx2_pairs(d,
+						_mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1)),
+						_mm256_cvtepu16_epi32(_mm256_extracti128_si256(v1, 1)),
+						_mm256_cvtepi16_epi32(_mm256_extracti128_si256(hv, 1)), r >> 8);
+				}
+			}
+			s += n;
+		}
+	}
+	*b = d;
+	return s;
+}
+
+/* size of a window, in which the terminating 0 is searched before converting its part by the AVX2 engine */
+#define UTF16_Z_WINDOW 2048
+
+/* AVX2 engine for 0-terminated utf16 string: convert its parts known not to contain the terminating 0 */
+UTF_TARGET_AVX2
+static const UTF16_CHAR_T *utf16_to_utf32_z_avx2(
+	const UTF16_CHAR_T *s, UTF32_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF32_CHAR_T *const e)
+{
+	const UTF16_CHAR_T *z = s;
+	for (;;) {
+		const UTF16_CHAR_T *const p = z + UTF16_Z_WINDOW;
+		z += utf_avx2_find0(z, UTF16_Z_WINDOW, sizeof(*z));
+		s = utf16_to_utf32_avx2(s, z, b, e);
+		if (z != p || (size_t)(z - s) >= 32)
+			return s; /* 0 was found or the engine has stopped not because of the window end */
+	}
+}
+
+/* AVX2 engine of the size-only pass: validate blocks of 16 utf16_char_t's while more than 16 of them remain,
+  stops before a block containing invalid utf16 character, so the scalar code reports it at exact position,
+  leaves at least one utf16_char_t (at most 16 and a high surrogate, if not stopped before invalid character),
+  adds to (*pm) the number of surrogate pairs among the validated utf16_char_t's,
+  returns pointer beyond the last validated utf16_char_t */
+UTF_TARGET_AVX2
+static const UTF16_CHAR_T *utf16_to_utf32_size_avx2(
+	const UTF16_CHAR_T *s, const UTF16_CHAR_T *const se, size_t *const pm)
+{
+	size_t m = 0;
+	unsigned hc = 0; /* 3 if the previous block ends with a high surrogate */
+	while ((size_t)(se - s) > 16) {
+		unsigned lo;
+		if (!utf16_avx2_check(utf16_to_utf32_avx2_load(s), &hc, &lo))
+			break; /* invalid utf16 character */
+		m += utf_popcnt32(lo)/2;
+		s += 16;
+	}
+	if (hc)
+		s--; /* leave the high surrogate at the end of the last validated block for the scalar code */
+	*pm += m;
+	return s;
+}
+
+/* AVX2 engine of the size-only pass for 0-terminated utf16 string: validate its part before the terminating 0 */
+UTF_TARGET_AVX2
+static const UTF16_CHAR_T *utf16_to_utf32_z_size_avx2(const UTF16_CHAR_T *s, size_t *const pm)
+{
+	const UTF16_CHAR_T *z = s;
+	for (;;) {
+		const UTF16_CHAR_T *const p = z + UTF16_Z_WINDOW;
+		z += utf_avx2_find0(z, UTF16_Z_WINDOW, sizeof(*z));
+		s = utf16_to_utf32_size_avx2(s, z, pm);
+		if (z != p || (size_t)(z - s) > 17)
+			return s; /* 0 was found or the engine has stopped before invalid utf16 character */
+	}
+}
+
+#endif /* LIBUTF16_AVX2 */
+
+/* convert a run of non-surrogate utf16_char_t's, 4 utf16_char_t's at a time,
+  there must be more than 4 utf16_char_t's in the source buffer and more than 4 free utf32_char_t's in the destination,
+  returns pointer to the first non-converted utf16_char_t, at least one utf16_char_t and one free utf32_char_t are left */
+static const UTF16_CHAR_T *utf16_to_utf32_bmp(
+	const UTF16_CHAR_T *s, const UTF16_CHAR_T *const se,
+	UTF32_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF32_CHAR_T *const e)
+{
+	UTF32_CHAR_T *d = *b;
+	size_t n = (size_t)(se - s);
+	if (n > (size_t)(e - (const UTF32_CHAR_T*)d))
+		n = (size_t)(e - (const UTF32_CHAR_T*)d);
+	do {
+		const utf_word64_t w = utf_load64(s);
+		UTF16_CHAR_T c[4];
+		unsigned i = 0;
+		if (utf16_swar_has_surrogate(w)) {
+			/* convert utf16_char_t's before the surrogate */
+			for (; 0xD800 != (UTF16_GET(s + i) & 0xF800); i++)
+				UTF32_PUT(d + i, (utf32_char_t)UTF16_GET(s + i));
+			s += i;
+			d += i;
+			break;
+		}
+		memcpy(c, &w, sizeof(c));
+		for (; i < 4; i++)
+			UTF32_PUT(d + i, (utf32_char_t)UTF16_GET((const UTF16_CHAR_T*)c + i));
+		s += 4;
+		d += 4;
+		n -= 4;
+	} while (n > 4);
+	*b = d;
+	return s;
+}
+
 /*
  utf16_to_utf32_z_
  utf16_to_utf32x_z_
@@ -72,6 +281,10 @@ size_t UTF_FORM_NAME(_z_)(
 	if (sz) {
 		UTF32_CHAR_T *LIBUTF16_RESTRICT d = *b;
 		const UTF32_CHAR_T *const e = (const UTF32_CHAR_T*)d + sz;
+#ifdef UTF16_TO_UTF32_AVX2
+		if (sz > 16 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+			s = utf16_to_utf32_z_avx2(s, &d, e);
+#endif
 		do {
 			unsigned c = UTF16_GET(s++);
 			if (0xD800 == (c & 0xFC00)) {
@@ -117,6 +330,10 @@ size_t UTF_FORM_NAME(_z_)(
 		determ_size = 0;
 	{
 		const UTF16_CHAR_T *const t = s; /* points beyond the last converted non-0 utf16_char_t */
+#ifdef UTF16_TO_UTF32_AVX2
+		if (libutf16_cpu_features() & UTF_CPU_AVX2)
+			s = utf16_to_utf32_z_size_avx2(s, &m);
+#endif
 		for (;;) {
 			unsigned c = UTF16_GET(s++);
 			if (0xD800 == (c & 0xFC00)) {
@@ -172,6 +389,10 @@ size_t UTF_FORM_NAME(_)(
 		if (sz) {
 			UTF32_CHAR_T *LIBUTF16_RESTRICT d = *b;
 			const UTF32_CHAR_T *const e = (const UTF32_CHAR_T*)d + sz;
+#ifdef UTF16_TO_UTF32_AVX2
+			if (libutf16_cpu_features() & UTF_CPU_AVX2)
+				s = utf16_to_utf32_avx2(s, se, &d, e);
+#endif
 			do {
 				unsigned c = UTF16_GET(s++);
 				if (0xD800 == (c & 0xFC00)) {
@@ -189,6 +410,13 @@ size_t UTF_FORM_NAME(_)(
 					*b = d;
 					return 0; /* bad utf16 surrogate pair: missing high surrogate */
 				}
+				else if ((size_t)(se - s) > 4 && (size_t)(e - (const UTF32_CHAR_T*)d) > 5 &&
+					0xD800 != (UTF16_GET(s) & 0xF800))
+				{
+					UTF32_PUT(d++, (utf32_char_t)c);
+					s = utf16_to_utf32_bmp(s, se, &d, e);
+					continue; /* (d != e) */
+				}
 				UTF32_PUT(d++, (utf32_char_t)c);
 				if (se == s) {
 					sz = (size_t)(d - *b);
@@ -209,6 +437,10 @@ size_t UTF_FORM_NAME(_)(
 			return 1;
 		{
 			const UTF16_CHAR_T *const t = s; /* points beyond the last converted utf16_char_t, t < se */
+#ifdef UTF16_TO_UTF32_AVX2
+			if ((size_t)(se - s) > 16 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+				s = utf16_to_utf32_size_avx2(s, se, &m);
+#endif
 			do {
 				unsigned c = UTF16_GET(s++);
 				if (0xD800 == (c & 0xFC00)) {
@@ -233,6 +465,233 @@ size_t UTF_FORM_NAME(_)(
 	return 0; /* n is zero */
 }
 
+#ifndef UTF_PUT_UNALIGNED
+/*
+ utf16_to_utf32_alloc
+ utf16_to_utf32x_alloc
+ utf16x_to_utf32_alloc
+ utf16x_to_utf32x_alloc
+ utf16u_to_utf32_alloc
+ utf16u_to_utf32x_alloc
+ utf16ux_to_utf32_alloc
+ utf16ux_to_utf32x_alloc
+*/
+size_t UTF_FORM_NAME(_alloc)(
+	const UTF16_CHAR_T **const LIBUTF16_RESTRICT q,
+	UTF32_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t n, const int shrink)
+{
+	UTF32_CHAR_T *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	buf = (UTF32_CHAR_T*)utf_alloc_buf(UTF16_TO_UTF32_MAX(n), sizeof(*buf));
+	if (!buf)
+		return (size_t)-1; /* not enough memory */
+	d = buf;
+	/* the output buffer is large enough, so the conversion may only fail on invalid input */
+	m = UTF_FORM_NAME(_)(q, &d, UTF16_TO_UTF32_MAX(n), n, /*determ_size:*/0);
+	if (!m) {
+		free(buf);
+		return 0; /* invalid utf16 string */
+	}
+	if (shrink && m < UTF16_TO_UTF32_MAX(n))
+		buf = (UTF32_CHAR_T*)utf_shrink_buf(buf, m*sizeof(*buf));
+	*b = buf;
+	return m;
+}
+
+/*
+ utf16_to_utf32_arena
+ utf16_to_utf32x_arena
+ utf16x_to_utf32_arena
+ utf16x_to_utf32x_arena
+ utf16u_to_utf32_arena
+ utf16u_to_utf32x_arena
+ utf16ux_to_utf32_arena
+ utf16ux_to_utf32x_arena
+*/
+size_t UTF_FORM_NAME(_arena)(
+	const UTF16_CHAR_T **const LIBUTF16_RESTRICT q,
+	UTF32_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t n, utf_arena_t *const LIBUTF16_RESTRICT a)
+{
+	UTF32_CHAR_T *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	if (n <= a->chunk_size/sizeof(*buf)/UTF16_TO_UTF32_MAX(1)) {
+		/* worst-case size fits in a chunk: allocate it and then return unused tail to the arena */
+		buf = (UTF32_CHAR_T*)utf_arena_alloc(a, UTF16_TO_UTF32_MAX(n)*sizeof(*buf));
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		/* the output buffer is large enough, so the conversion may only fail on invalid input */
+		m = UTF_FORM_NAME(_)(q, &d, UTF16_TO_UTF32_MAX(n), n, /*determ_size:*/0);
+		utf_arena_trim(a, m ? d : buf);
+		if (!m)
+			return 0; /* invalid utf16 string */
+	}
+	else {
+		/* long string: determine exact size of the output buffer, then convert without validating again */
+		utf_valid_token_t t;
+		m = UTF_FORM_NAME(_size_token)(q, n, &t);
+		if (!m)
+			return 0; /* invalid utf16 string */
+		buf = m <= (size_t)-1/sizeof(*buf) ? (UTF32_CHAR_T*)utf_arena_alloc(a, m*sizeof(*buf)) : NULL;
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		(void)UTF_FORM_NAME(_from_token)(&t, &d, m);
+		*q = (const UTF16_CHAR_T*)*q + n;
+	}
+	*b = buf;
+	return m;
+}
+
+/*
+ utf16_to_utf32_grow
+ utf16_to_utf32x_grow
+ utf16x_to_utf32_grow
+ utf16x_to_utf32x_grow
+ utf16u_to_utf32_grow
+ utf16u_to_utf32x_grow
+ utf16ux_to_utf32_grow
+ utf16ux_to_utf32x_grow
+*/
+size_t UTF_FORM_NAME(_grow)(
+	const UTF16_CHAR_T **const LIBUTF16_RESTRICT q,
+	utf_grow_buf_t *const LIBUTF16_RESTRICT g,
+	size_t n)
+{
+	const size_t len = g->len;
+	while (n) {
+		if (g->len != g->cap) {
+			const UTF16_CHAR_T *const s = *q;
+			UTF32_CHAR_T *const o = (UTF32_CHAR_T*)g->buf + g->len;
+			UTF32_CHAR_T *d = o;
+			const size_t sz = g->cap - g->len;
+			const size_t m = UTF_FORM_NAME(_)(q, &d, sz, n, /*determ_size:*/0);
+			g->len += (size_t)(d - o);
+			if (!m)
+				return 0; /* invalid/incomplete utf16 character */
+			if (m <= sz)
+				return g->len - len; /* ok, all 'n' utf16_char_t's were converted */
+			/* output buffer is full, continue from the last converted utf16_char_t */
+			n -= (size_t)(*q - s);
+		}
+		/* each of remaining utf16_char_t's produces at most one utf32_char_t */
+		if (!utf_grow_buf(g, n, sizeof(UTF32_CHAR_T)))
+			return (size_t)-1; /* not enough memory */
+	}
+	return 0; /* n is zero */
+}
+#endif
+
+/*
+ utf16_to_utf32_size_token
+ utf16_to_utf32x_size_token
+ utf16_to_utf32u_size_token
+ utf16_to_utf32ux_size_token
+ utf16x_to_utf32_size_token
+ utf16x_to_utf32x_size_token
+ utf16x_to_utf32u_size_token
+ utf16x_to_utf32ux_size_token
+ utf16u_to_utf32_size_token
+ utf16u_to_utf32x_size_token
+ utf16u_to_utf32u_size_token
+ utf16u_to_utf32ux_size_token
+ utf16ux_to_utf32_size_token
+ utf16ux_to_utf32x_size_token
+ utf16ux_to_utf32u_size_token
+ utf16ux_to_utf32ux_size_token
+*/
+size_t UTF_FORM_NAME(_size_token)(
+	const UTF16_CHAR_T **const LIBUTF16_RESTRICT q,
+	const size_t n,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const size_t sz = UTF_FORM_NAME(_)(q, /*b:*/NULL, /*sz:*/0, n, /*determ_size:*/1);
+	t->src = sz ? *q : NULL;
+	t->n = sz ? n : 0;
+	t->size = sz;
+	t->kind = sz ? UTF_TOKEN_KIND : 0;
+	return sz;
+}
+
+/*
+ utf16_to_utf32_z_size_token
+ utf16_to_utf32x_z_size_token
+ utf16_to_utf32u_z_size_token
+ utf16_to_utf32ux_z_size_token
+ utf16x_to_utf32_z_size_token
+ utf16x_to_utf32x_z_size_token
+ utf16x_to_utf32u_z_size_token
+ utf16x_to_utf32ux_z_size_token
+ utf16u_to_utf32_z_size_token
+ utf16u_to_utf32x_z_size_token
+ utf16u_to_utf32u_z_size_token
+ utf16u_to_utf32ux_z_size_token
+ utf16ux_to_utf32_z_size_token
+ utf16ux_to_utf32x_z_size_token
+ utf16ux_to_utf32u_z_size_token
+ utf16ux_to_utf32ux_z_size_token
+*/
+size_t UTF_FORM_NAME(_z_size_token)(
+	const UTF16_CHAR_T **const LIBUTF16_RESTRICT q,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const UTF16_CHAR_T *const s = *q;
+	const size_t sz = UTF_FORM_NAME(_z_)(q, /*b:*/NULL, /*sz:*/0, /*determ_size:*/2);
+	if (!sz) {
+		t->src = NULL;
+		t->n = 0;
+		t->size = 0;
+		t->kind = 0;
+		return 0; /* invalid utf16 string */
+	}
+	t->src = s;
+	t->n = (size_t)(*q - s);
+	t->size = sz;
+	t->kind = UTF_TOKEN_KIND;
+	*q = s; /* (*q) was moved beyond the 0-terminator */
+	return sz;
+}
+
+/*
+ utf16_to_utf32_from_token
+ utf16_to_utf32x_from_token
+ utf16_to_utf32u_from_token
+ utf16_to_utf32ux_from_token
+ utf16x_to_utf32_from_token
+ utf16x_to_utf32x_from_token
+ utf16x_to_utf32u_from_token
+ utf16x_to_utf32ux_from_token
+ utf16u_to_utf32_from_token
+ utf16u_to_utf32x_from_token
+ utf16u_to_utf32u_from_token
+ utf16u_to_utf32ux_from_token
+ utf16ux_to_utf32_from_token
+ utf16ux_to_utf32x_from_token
+ utf16ux_to_utf32u_from_token
+ utf16ux_to_utf32ux_from_token
+*/
+size_t UTF_FORM_NAME(_from_token)(
+	const utf_valid_token_t *const LIBUTF16_RESTRICT t,
+	UTF32_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t sz)
+{
+	const UTF16_CHAR_T *q = (const UTF16_CHAR_T*)t->src;
+	if (t->kind != UTF_TOKEN_KIND)
+		return 0; /* the token is empty or was filled by another conversion */
+	if (t->size > sz)
+		return t->size; /* output buffer is too small */
+	/* validation of utf16 string is cheap, use checked code */
+	return UTF_FORM_NAME(_)(&q, b, t->size, t->n, /*determ_size:*/0);
+}
+
 /*
  utf16_to_utf32_z_unsafe
  utf16_to_utf32x_z_unsafe
@@ -22,6 +22,8 @@
 #include "libutf16/utf16_swap.h"
 
 #include "utf16_internal.h"
+#include "utf16_simd.h"
+#include "utf16_swar.h"
 
 #ifdef _MSC_VER
 #pragma warning(disable:5045) /* Compiler will insert Spectre mitigation for memory load if /Qspectre switch specified */
@@ -37,6 +39,490 @@
 #define UTF_FORM_NAME1(fu, fx, suffix)  UTF_FORM_NAME2(fu, fx, suffix)
 #define UTF_FORM_NAME(suffix)           UTF_FORM_NAME1(UTF_GET_U, UTF16_X, suffix)
 
+/* kind of tokens of validated strings, filled and accepted by this form of conversion */
+#define UTF_TOKEN_KIND (UTF_TOKEN_UTF16_TO_UTF8 | UTF16_TOKEN_X | UTF_TOKEN_GET_U)
+
+#ifdef LIBUTF16_AVX512
+#define UTF16_TO_UTF8_AVX512
+
+/* swap bytes of utf16_char_t's loaded by the AVX-512 engine */
+#ifdef SWAP_UTF16
+#define UTF16_AVX512_SWAP(x) _mm512_shldi_epi16(x, x, 8)
+#else
+#define UTF16_AVX512_SWAP(x) (x)
+#endif
+
+/* AVX-512 engine: validate and convert a block of l (1..32) utf16_char_t's, lanes of x beyond the l-th are zero,
+  the block is converted at once if it consists of one-byte utf8 characters, else only up to first 16 utf16_char_t's
+  are converted; high surrogate at the end of the block is left for the next block.
+  fill - the input ends with the block and the output buffer may be filled completely
+  (if the converted utf16_char_t's are the last ones), else there must remain a space for at least
+  one utf8_char_t after the converted ones.
+  Uses masked stores, so writes nothing beyond the converted utf8_char_t's.
+  Returns number of converted utf16_char_t's, 0 if the block starts with invalid utf16 character
+  or there is not enough space in the output buffer, updates (*pd) */
+UTF_TARGET_AVX512
+static UTF_FORCE_INLINE unsigned utf16_to_utf8_avx512_block(const __m512i x, unsigned l,
+	utf8_char_t **const pd, const utf8_char_t *const e, const int fill)
+{
+	const size_t room = (size_t)(e - *pd);
+	if (!_mm512_cmpgt_epu16_mask(x, _mm512_set1_epi16(0x7F))) {
+		if (l >= room + !!fill)
+			return 0; /* not enough space in the output buffer */
+		_mm512_mask_cvtepi16_storeu_epi8(*pd, _bzhi_u32(0xFFFFFFFFu, l), x);
+		*pd += l;
+		return l;
+	}
+	{
+		const __m512i c = _mm512_cvtepu16_epi32(_mm512_castsi512_si256(x));
+		const unsigned hs = (__mmask16)_mm512_cmpeq_epi32_mask(
+			_mm512_and_si512(c, _mm512_set1_epi32(0xFC00)), _mm512_set1_epi32(0xD800));
+		const unsigned ls = (__mmask16)_mm512_cmpeq_epi32_mask(
+			_mm512_and_si512(c, _mm512_set1_epi32(0xFC00)), _mm512_set1_epi32(0xDC00));
+		const int last = fill && l <= 16; /* the input ends with the first 16 utf16_char_t's */
+		unsigned bad, n;
+		__mmask64 keep;
+		__m512i v;
+		if (l > 16)
+			l = 16;
+		/* each high surrogate must be followed by low one, each low surrogate must follow high one */
+		bad = (ls ^ (hs << 1)) & _bzhi_u32(0xFFFF, l);
+		n = l - ((hs >> (l - 1)) & 1); /* high surrogate at the end: the pair is incomplete */
+		if (bad) {
+			unsigned p = utf_bsf32(bad);
+			p -= p && ((hs >> (p - 1)) & 1); /* missing low surrogate */
+			if (n > p)
+				n = p;
+		}
+		if (!n)
+			return 0; /* invalid utf16 character */
+		/* 110110xxyyyyyyyy 110111aabbbbbbbb -> 1xxyyyyyyyyaabbbbbbbb - 0x10000 */
+		v = utf8_avx512_encode(
+			_mm512_mask_sub_epi32(c, (__mmask16)hs,
+				_mm512_add_epi32(_mm512_slli_epi32(c, 10), _mm512_alignr_epi32(_mm512_setzero_si512(), c, 1)),
+				_mm512_set1_epi32(0x35FDC00)),
+			(__mmask16)(_bzhi_u32(0xFFFF, n) & ~ls), &keep);
+		{
+			const unsigned k = utf_popcnt64(keep);
+			if (k >= room + (last && n == l))
+				return 0; /* not enough space in the output buffer */
+			_mm512_mask_storeu_epi8(*pd, _bzhi_u64(~0ull, k), _mm512_maskz_compress_epi8(keep, v));
+			*pd += k;
+		}
+		return n;
+	}
+}
+
+/* AVX-512 engine: validate and convert blocks of up to 32 utf16_char_t's, the last block is read by a masked load:
+ - stops at invalid utf16 character, so the scalar code reports it at exact position,
+ - stops if there is not enough space in the output buffer for the next block,
+ - if not all utf16_char_t's are converted, leaves a space for at least one utf8_char_t in the output buffer.
+ returns pointer beyond the last converted utf16_char_t, updates (*b) */
+UTF_TARGET_AVX512
+static const UTF16_CHAR_T *utf16_to_utf8_avx512(
+	const UTF16_CHAR_T *s, const UTF16_CHAR_T *const se,
+	utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	utf8_char_t *d = *b;
+	do {
+		const size_t k = (size_t)(se - s);
+		const unsigned l = k < 32 ? (unsigned)k : 32u;
+		const unsigned n = utf16_to_utf8_avx512_block(
+			UTF16_AVX512_SWAP(_mm512_maskz_loadu_epi16(_bzhi_u32(0xFFFFFFFFu, l), s)), l, &d, e, k <= 32);
+		if (!n)
+			break;
+		s += n;
+	} while (s != se);
+	*b = d;
+	return s;
+}
+
+/* AVX-512 engine for 0-terminated utf16 string: convert its part before the terminating 0,
+  never reading memory beyond the page containing the terminating 0,
+  leaves a space for at least one utf8_char_t in the output buffer */
+UTF_TARGET_AVX512
+static const UTF16_CHAR_T *utf16_to_utf8_z_avx512(
+	const UTF16_CHAR_T *s, utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	utf8_char_t *d = *b;
+	for (;;) {
+		__m512i x = utf_avx512_load_z(s, sizeof(*s));
+		const __mmask32 z = _mm512_testn_epi16_mask(x, x);
+		unsigned l = 32, n;
+		if (z) {
+			l = utf_bsf32(z);
+			if (!l)
+				break; /* the terminating 0 */
+			x = _mm512_maskz_mov_epi16(_bzhi_u32(0xFFFFFFFFu, l), x);
+		}
+		n = utf16_to_utf8_avx512_block(UTF16_AVX512_SWAP(x), l, &d, e, /*fill:*/0);
+		s += n;
+		if (!n || (n == l && l != 32))
+			break; /* invalid utf16 character, not enough space in the output buffer or the terminating 0 is reached */
+	}
+	*b = d;
+	return s;
+}
+
+/* minimal length of utf16 string for the AVX-512 engine, shorter strings are faster converted by the scalar code */
+#define UTF16_AVX512_MIN 8
+
+#endif /* LIBUTF16_AVX512 */
+
+#ifdef LIBUTF16_AVX2
+#define UTF16_TO_UTF8_AVX2
+
+/* load 16 utf16_char_t's */
+UTF_TARGET_AVX2
+static inline __m256i utf16_to_utf8_avx2_load(const UTF16_CHAR_T *const s)
+{
+#ifdef SWAP_UTF16
+	return _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)s), _mm256_setr_epi8(
+		1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+#else
+	return _mm256_loadu_si256((const __m256i*)s);
+#endif
+}
+
+/* encode 8 utf16_char_t's (zero-extended to 32 bits, no surrogates) to utf8 characters:
+  g1 - lanes of characters >= 0x80, g2 - lanes of characters >= 0x800, m1, m2 - their bit masks,
+  store them to d, returns pointer beyond the stored characters, may store up to 16 garbage bytes after it */
+UTF_TARGET_AVX2
+static inline utf8_char_t *utf16_to_utf8_avx2_encode(
+	utf8_char_t *d, const __m256i c, const __m256i g1, const __m256i g2,
+	const unsigned m1, const unsigned m2)
+{
+	const __m256i t = _mm256_or_si256(_mm256_and_si256(c, _mm256_set1_epi32(0x3F)), _mm256_set1_epi32(0x80));
+	/* 00000aaaaabbbbbb -> 110aaaaa 10bbbbbb */
+	__m256i v = _mm256_blendv_epi8(c,
+		_mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(c, 6), _mm256_set1_epi32(0xC0)), _mm256_slli_epi32(t, 8)), g1);
+	if (m2) {
+		/* aaaabbbbbbcccccc -> 1110aaaa 10bbbbbb 10cccccc */
+		v = _mm256_blendv_epi8(v,
+			_mm256_or_si256(
+				_mm256_or_si256(_mm256_srli_epi32(c, 12), _mm256_set1_epi32(0xE0)),
+				_mm256_or_si256(
+					_mm256_slli_epi32(_mm256_or_si256(
+						_mm256_and_si256(_mm256_srli_epi32(c, 6), _mm256_set1_epi32(0x3F)), _mm256_set1_epi32(0x80)), 8),
+					_mm256_slli_epi32(t, 16))), g2);
+	}
+	v = _mm256_shuffle_epi8(v, _mm256_inserti128_si256(_mm256_castsi128_si256(
+		_mm_loadu_si128((const __m128i*)libutf16_utf8_pack32_shuf[(m1 & 0xF) | (m2 & 0xF) << 4])),
+		_mm_loadu_si128((const __m128i*)libutf16_utf8_pack32_shuf[(m1 >> 4) | (m2 & 0xF0)]), 1));
+	_mm_storeu_si128((__m128i*)d, _mm256_castsi256_si128(v));
+	d += 4 + utf_popcnt32((m1 & 0xF) | (m2 & 0xF) << 4);
+	_mm_storeu_si128((__m128i*)d, _mm256_extracti128_si256(v, 1));
+	return d + 4 + utf_popcnt32((m1 >> 4) | (m2 & 0xF0));
+}
+
+/* AVX2 engine: convert blocks of 16 utf16_char_t's,
+  while at least 64 utf16_char_t's remain in the input and there are at least 64 bytes in the output buffer:
+ - characters before a surrogate pair are converted by the vector code, the pair itself - by the scalar one,
+ - stops at invalid utf16 character, so the scalar code reports it at exact position,
+ - may store up to 52 garbage bytes beyond the (*b), they are overwritten while converting
+  remaining (at least 64) utf16_char_t's.
+ returns pointer beyond the last converted utf16_char_t, updates (*b) */
+UTF_TARGET_AVX2
+static const UTF16_CHAR_T *utf16_to_utf8_avx2(
+	const UTF16_CHAR_T *s, const UTF16_CHAR_T *const se,
+	utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	utf8_char_t *d = *b;
+	while ((size_t)(se - s) >= 64 && (size_t)(e - d) >= 64) {
+		const __m256i v = utf16_to_utf8_avx2_load(s);
+		if (_mm256_testz_si256(v, _mm256_set1_epi16((short)0xFF80))) {
+			/* all characters are < 0x80 */
+			_mm_storeu_si128((__m128i*)d, _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+			s += 16;
+			d += 16;
+		}
+		else {
+			/* 2 bits per surrogate */
+			const unsigned sur = (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi16(
+				_mm256_and_si256(v, _mm256_set1_epi16((short)0xF800)), _mm256_set1_epi16((short)0xD800)));
+			unsigned n = 16;
+			if (sur) {
+				n = utf_bsf32(sur) / 2;
+				if (!n) {
+					/* convert a run of surrogate pairs */
+					do {
+						unsigned c = UTF16_GET(s);
+						const unsigned r = UTF16_GET(s + 1);
+						if (0xD800 != (c & 0xFC00) || 0xDC00 != (r & 0xFC00))
+							goto stop; /* bad utf16 surrogate pair */
+						c = (c << 10) + r - 0x35FDC00;
+						d[0] = (utf8_char_t)(0xF0 | (c >> 18));
+						d[1] = (utf8_char_t)(0x80 | ((c >> 12) & 0x3F));
+						d[2] = (utf8_char_t)(0x80 | ((c >> 6) & 0x3F));
+						d[3] = (utf8_char_t)(0x80 | (c & 0x3F));
+						s += 2;
+						d += 4;
+					} while ((size_t)(se - s) >= 64 && (size_t)(e - d) >= 64 && 0xD800 == (UTF16_GET(s) & 0xF800));
+					continue;
+				}
+			}
+			{
+				const __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v));
+				const __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1));
+				const __m256i g1_lo = _mm256_cmpgt_epi32(lo, _mm256_set1_epi32(0x7F));
+				const __m256i g1_hi = _mm256_cmpgt_epi32(hi, _mm256_set1_epi32(0x7F));
+				const __m256i g2_lo = _mm256_cmpgt_epi32(lo, _mm256_set1_epi32(0x7FF));
+				const __m256i g2_hi = _mm256_cmpgt_epi32(hi, _mm256_set1_epi32(0x7FF));
+				const unsigned m1 = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(g1_lo)) |
+					(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(g1_hi)) << 8;
+				const unsigned m2 = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(g2_lo)) |
+					(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(g2_hi)) << 8;
+				utf8_char_t *t = utf16_to_utf8_avx2_encode(d, lo, g1_lo, g2_lo, m1 & 0xFF, m2 & 0xFF);
+				if (n > 8)
+					t = utf16_to_utf8_avx2_encode(t, hi, g1_hi, g2_hi, m1 >> 8, m2 >> 8);
+				if (n == 16)
+					d = t;
+				else {
+					/* characters before a surrogate */
+					const unsigned k = (1u << n) - 1;
+					d += n + utf_popcnt32(m1 & k) + utf_popcnt32(m2 & k);
+				}
+				s += n;
+			}
+		}
+	}
+stop:
+	*b = d;
+	return s;
+}
+
+/* size of a window, in which the terminating 0 is searched before converting its part by the AVX2 engine */
+#define UTF16_Z_WINDOW 2048
+
+/* AVX2 engine for 0-terminated utf16 string: convert its parts known not to contain the terminating 0 */
+UTF_TARGET_AVX2
+static const UTF16_CHAR_T *utf16_to_utf8_z_avx2(
+	const UTF16_CHAR_T *s, utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	const UTF16_CHAR_T *z = s;
+	for (;;) {
+		const UTF16_CHAR_T *const p = z + UTF16_Z_WINDOW;
+		z += utf_avx2_find0(z, UTF16_Z_WINDOW, sizeof(*z));
+		s = utf16_to_utf8_avx2(s, z, b, e);
+		if (z != p || (size_t)(z - s) >= 64)
+			return s; /* 0 was found or the engine has stopped not because of the window end */
+	}
+}
+
+/* strings shorter than this are converted by the short-string kernel */
+#define UTF16_AVX2_SHORT 32
+
+/* shorter strings of non-ascii characters are converted faster by the scalar code */
+#define UTF16_AVX2_SHORT_MIXED 8
+
+/* strings converted by the AVX-512 engine are not passed to the short-string kernel */
+#ifdef UTF16_TO_UTF8_AVX512
+#define UTF16_AVX2_SHORT_USE(n) ((n) < UTF16_AVX512_MIN || !(libutf16_cpu_features() & UTF_CPU_AVX512))
+#else
+#define UTF16_AVX2_SHORT_USE(n) 1
+#endif
+
+/* short-string kernel: load n <= 16 utf16_char_t's, zeroing the rest of the vector */
+UTF_TARGET_AVX2
+static inline __m256i utf16_to_utf8_avx2_load_short(const UTF16_CHAR_T *const s, const unsigned n)
+{
+#ifdef SWAP_UTF16
+	return _mm256_shuffle_epi8(utf_avx2_load_short(s, n*2), _mm256_setr_epi8(
+		1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+#else
+	return utf_avx2_load_short(s, n*2);
+#endif
+}
+
+/* short-string kernel: convert n < UTF16_AVX2_SHORT utf16_char_t's at once, if there are no surrogates among them
+  and the output buffer of sz bytes is large enough, bytes beyond the converted utf8_char_t's are not touched,
+  if mixed is zero, converts only a string of ascii characters,
+  returns the number of stored utf8_char_t's, 0 - if the string was not converted */
+UTF_TARGET_AVX2
+static unsigned utf16_to_utf8_avx2_short(
+	const UTF16_CHAR_T *const s, const unsigned n/*>0*/, utf8_char_t *const d, const size_t sz, const int mixed)
+{
+	const __m256i v[2] = {
+		utf16_to_utf8_avx2_load_short(s, n < 16 ? n : 16),
+		n > 16 ? utf16_to_utf8_avx2_load_short(s + 16, n - 16) : _mm256_setzero_si256()
+	};
+	const __m256i a = _mm256_or_si256(v[0], v[1]);
+	if (_mm256_testz_si256(a, _mm256_set1_epi16((short)0xFF80))) {
+		/* all characters are < 0x80 */
+		if (sz < n)
+			return 0;
+		utf_avx2_store_short(d, _mm256_permute4x64_epi64(_mm256_packus_epi16(v[0], v[1]), 0xD8), n);
+		return n;
+	}
+	if (!mixed)
+		return 0;
+	if (!_mm256_testz_si256(
+		_mm256_cmpeq_epi16(_mm256_and_si256(v[0], _mm256_set1_epi16((short)0xF800)), _mm256_set1_epi16((short)0xD800)),
+		_mm256_set1_epi8(-1)) ||
+		!_mm256_testz_si256(
+		_mm256_cmpeq_epi16(_mm256_and_si256(v[1], _mm256_set1_epi16((short)0xF800)), _mm256_set1_epi16((short)0xD800)),
+		_mm256_set1_epi8(-1)))
+	{
+		return 0; /* surrogates are converted by the scalar code */
+	}
+	{
+		/* zeros following the string give one utf8_char_t each, at the end of the converted ones */
+		utf8_char_t t[112];
+		utf8_char_t *p = t;
+		unsigned i = 0, l;
+		for (; i < n; i += 8) {
+			const __m256i c = _mm256_cvtepu16_epi32(8 & i ?
+				_mm256_extracti128_si256(v[i >> 4], 1) : _mm256_castsi256_si128(v[i >> 4]));
+			const __m256i g1 = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0x7F));
+			const __m256i g2 = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0x7FF));
+			p = utf16_to_utf8_avx2_encode(p, c, g1, g2,
+				(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(g1)),
+				(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(g2)));
+		}
+		l = (unsigned)(p - t) - (i - n);
+		if (sz < l)
+			return 0;
+		for (i = 0; i < l; i += 32)
+			utf_avx2_store_short(d + i, _mm256_loadu_si256((const __m256i*)(t + i)), l - i < 32 ? l - i : 32);
+		return l;
+	}
+}
+
+/* AVX2 engine of the size-only pass: validate blocks of 16 utf16_char_t's while more than 16 of them remain,
+  stops before a block containing invalid utf16 character, so the scalar code reports it at exact position,
+  leaves at least one utf16_char_t (at most 16 and a high surrogate, if not stopped before invalid character),
+  adds to (*pm) the number of utf8_char_t's the validated utf16_char_t's are converted to, minus their number,
+  returns pointer beyond the last validated utf16_char_t */
+UTF_TARGET_AVX2
+static const UTF16_CHAR_T *utf16_to_utf8_size_avx2(
+	const UTF16_CHAR_T *s, const UTF16_CHAR_T *const se, size_t *const pm)
+{
+	size_t m = 0;
+	unsigned hc = 0; /* 3 if the previous block ends with a high surrogate */
+	while ((size_t)(se - s) > 16) {
+		const __m256i v = utf16_to_utf8_avx2_load(s);
+		if (!_mm256_testz_si256(v, _mm256_set1_epi16((short)0xFF80))) {
+			/* 2 bits per utf16_char_t */
+			const unsigned g1 = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi16(
+				_mm256_and_si256(v, _mm256_set1_epi16((short)0xFF80)), _mm256_setzero_si256()));
+			const unsigned g2 = ~(unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi16(
+				_mm256_and_si256(v, _mm256_set1_epi16((short)0xF800)), _mm256_setzero_si256()));
+			unsigned lo;
+			if (!utf16_avx2_check(v, &hc, &lo))
+				break; /* invalid utf16 character */
+			/* + 1 for characters >= 0x80, + 1 for characters >= 0x800, surrogate pair - + 2 in total */
+			m += (utf_popcnt32(g1) + utf_popcnt32(g2))/2 - utf_popcnt32(lo);
+		}
+		else if (hc)
+			break; /* expecting low surrogate */
+		s += 16;
+	}
+	if (hc) {
+		/* leave the high surrogate at the end of the last validated block for the scalar code */
+		s--;
+		m -= 2;
+	}
+	*pm += m;
+	return s;
+}
+
+/* AVX2 engine of the size-only pass for 0-terminated utf16 string: validate its part before the terminating 0 */
+UTF_TARGET_AVX2
+static const UTF16_CHAR_T *utf16_to_utf8_z_size_avx2(const UTF16_CHAR_T *s, size_t *const pm)
+{
+	const UTF16_CHAR_T *z = s;
+	for (;;) {
+		const UTF16_CHAR_T *const p = z + UTF16_Z_WINDOW;
+		z += utf_avx2_find0(z, UTF16_Z_WINDOW, sizeof(*z));
+		s = utf16_to_utf8_size_avx2(s, z, pm);
+		if (z != p || (size_t)(z - s) > 17)
+			return s; /* 0 was found or the engine has stopped before invalid utf16 character */
+	}
+}
+
+#endif /* LIBUTF16_AVX2 */
+
+/* convert a run of ascii characters, 4 utf16_char_t's at a time,
+  there must be more than 4 utf16_char_t's in the source buffer and more than 4 free utf8_char_t's in the destination,
+  returns pointer to the first non-converted utf16_char_t, at least one utf16_char_t and one free utf8_char_t are left */
+static const UTF16_CHAR_T *utf16_to_utf8_ascii(
+	const UTF16_CHAR_T *s, const UTF16_CHAR_T *const se,
+	utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	utf8_char_t *d = *b;
+	size_t n = (size_t)(se - s);
+	if (n > (size_t)(e - d))
+		n = (size_t)(e - d);
+	do {
+		const utf_word64_t w = utf_load64(s);
+		UTF16_CHAR_T c[4];
+		unsigned i = 0;
+		if (w & UTF16_SWAR_NOT_ASCII) {
+			/* convert ascii characters before the non-ascii one */
+			for (; UTF16_GET(s + i) < 0x80; i++)
+				d[i] = (utf8_char_t)UTF16_GET(s + i);
+			s += i;
+			d += i;
+			break;
+		}
+		memcpy(c, &w, sizeof(c));
+		for (; i < 4; i++)
+			d[i] = (utf8_char_t)UTF16_GET((const UTF16_CHAR_T*)c + i);
+		s += 4;
+		d += 4;
+		n -= 4;
+	} while (n > 4);
+	*b = d;
+	return s;
+}
+
+/* convert utf16 characters, when the output buffer has a space for the worst-case expansion of them:
+  there must be at least 3 free utf8_char_t's in the destination for each utf16_char_t in the source buffer,
+  so the space in the output buffer need not be checked,
+  stops at the end of the input or before invalid utf16 character, so the checked loop reports it,
+  returns pointer beyond the last converted utf16_char_t, updates (*b) */
+static const UTF16_CHAR_T *utf16_to_utf8_wide(
+	const UTF16_CHAR_T *s, const UTF16_CHAR_T *const se,
+	utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	utf8_char_t *LIBUTF16_RESTRICT d = *b;
+	while (s != se) {
+		unsigned c = UTF16_GET(s);
+		if (c >= 0x80) {
+			if (c >= 0x800) {
+				if (0xD800 == (c & 0xF800)) {
+					unsigned r;
+					if (c >= 0xDC00 || (size_t)(se - s) < 2)
+						break; /* missing high surrogate or incomplete surrogate pair */
+					r = UTF16_GET(s + 1);
+					if (0xDC00 != (r & 0xFC00))
+						break; /* expecting lower surrogate */
+					s++;
+					c = (c << 10) + r - 0x20DC00 + 0x800000 + 0x10000;
+					*d++ = (utf8_char_t)(c >> 18);
+					c = (c & 0x3FFFF) + 0x80000;
+				}
+				else
+					c += 0xE0000;
+				*d++ = (utf8_char_t)(c >> 12);
+				c = (c & 0xFFF) + 0x2000;
+			}
+			else
+				c += 0x3000;
+			*d++ = (utf8_char_t)(c >> 6);
+			c = (c & 0x3F) + 0x80;
+		}
+		else if ((size_t)(se - s) > 4 && UTF16_GET(s + 1) < 0x80) {
+			s = utf16_to_utf8_ascii(s, se, &d, e);
+			continue;
+		}
+		*d++ = (utf8_char_t)c;
+		s++;
+	}
+	*b = d;
+	return s;
+}
+
 /*
  utf16_to_utf8_z_
  utf16x_to_utf8_z_
@@ -54,6 +540,15 @@ size_t UTF_FORM_NAME(_z_)(
 	if (sz) {
 		utf8_char_t *LIBUTF16_RESTRICT d = *b;
 		const utf8_char_t *const e = d + sz;
+#ifdef UTF16_TO_UTF8_AVX512
+		if (libutf16_cpu_features() & UTF_CPU_AVX512)
+			s = utf16_to_utf8_z_avx512(s, &d, e);
+		else
+#endif
+#ifdef UTF16_TO_UTF8_AVX2
+		if (sz >= 64 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+			s = utf16_to_utf8_z_avx2(s, &d, e);
+#endif
 		do {
 			unsigned c = UTF16_GET(s++);
 			if (c >= 0x80) {
@@ -152,6 +647,10 @@ size_t UTF_FORM_NAME(_z_)(
 		const UTF16_CHAR_T *const t = s - (m != 0) - (3 == m); /* points beyond the last converted non-0 utf16_char_t */
 		if (3 == m)
 			m = 2;
+#ifdef UTF16_TO_UTF8_AVX2
+		if (libutf16_cpu_features() & UTF_CPU_AVX2)
+			s = utf16_to_utf8_z_size_avx2(s, &m);
+#endif
 		for (;;) {
 			unsigned c = UTF16_GET(s++);
 			if (c >= 0x80) {
@@ -223,6 +722,44 @@ size_t UTF_FORM_NAME(_)(
 		if (sz) {
 			utf8_char_t *LIBUTF16_RESTRICT d = *b;
 			const utf8_char_t *const e = d + sz;
+#ifdef UTF16_TO_UTF8_AVX2
+			if (n > 1 && n < UTF16_AVX2_SHORT && (libutf16_cpu_features() & UTF_CPU_AVX2) &&
+				UTF16_AVX2_SHORT_USE(n))
+			{
+				const unsigned l = utf16_to_utf8_avx2_short(s, (unsigned)n, d, sz, n >= UTF16_AVX2_SHORT_MIXED);
+				if (l) {
+					*w = se;
+					*b = d + l;
+					return l; /* ok, >0 and <= dst buffer size */
+				}
+			}
+#endif
+#ifdef UTF16_TO_UTF8_AVX512
+			if (n >= UTF16_AVX512_MIN && (libutf16_cpu_features() & UTF_CPU_AVX512)) {
+				s = utf16_to_utf8_avx512(s, se, &d, e);
+				if (se == s) {
+					sz = (size_t)(d - *b);
+					*w = s; /* (*w) == se */
+					*b = d;
+					return sz; /* ok, >0 and <= dst buffer size */
+				}
+			}
+			else
+#endif
+#ifdef UTF16_TO_UTF8_AVX2
+			if (libutf16_cpu_features() & UTF_CPU_AVX2)
+				s = utf16_to_utf8_avx2(s, se, &d, e);
+#endif
+			if ((size_t)(e - d)/3 >= (size_t)(se - s)) {
+				/* output buffer is large enough for any utf16 string of remaining length */
+				s = utf16_to_utf8_wide(s, se, &d, e);
+				if (se == s) {
+					sz = (size_t)(d - *b);
+					*w = s; /* (*w) == se */
+					*b = d;
+					return sz; /* ok, >0 and <= dst buffer size */
+				}
+			}
 			do {
 				unsigned c = UTF16_GET(s++);
 				if (c >= 0x80) {
@@ -271,6 +808,11 @@ size_t UTF_FORM_NAME(_)(
 					d[-2] = (utf8_char_t)(c >> 6);
 					c = (c & 0x3F) + 0x80;
 				}
+				else if ((size_t)(se - s) > 4 && (size_t)(e - d) > 5 && UTF16_GET(s) < 0x80) {
+					*d++ = (utf8_char_t)c;
+					s = utf16_to_utf8_ascii(s, se, &d, e);
+					continue; /* (d != e) */
+				}
 				else
 					d++;
 				d[-1] = (utf8_char_t)c;
@@ -312,7 +854,11 @@ size_t UTF_FORM_NAME(_)(
 			const UTF16_CHAR_T *const t = s - (m != 0) - (3 == m); /* points beyond the last converted utf16_char_t, t < se */
 			if (3 == m)
 				m = 2;
-			do {
+#ifdef UTF16_TO_UTF8_AVX2
+			if ((size_t)(se - s) > 16 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+				s = utf16_to_utf8_size_avx2(s, se, &m);
+#endif
+			while (s != se) {
 				unsigned c = UTF16_GET(s++);
 				if (c >= 0x80) {
 					if (c >= 0x800) {
@@ -332,7 +878,7 @@ size_t UTF_FORM_NAME(_)(
 					}
 					m++;
 				}
-			} while (s != se);
+			}
 #ifdef UBSAN_UNSIGNED_OVERFLOW
 			if (sz > (size_t)-1 - m)
 				goto too_long;
@@ -362,6 +908,190 @@ too_long:
 	return 0; /* n is zero */
 }
 
+/*
+ utf16_to_utf8_alloc
+ utf16x_to_utf8_alloc
+ utf16u_to_utf8_alloc
+ utf16ux_to_utf8_alloc
+*/
+size_t UTF_FORM_NAME(_alloc)(
+	const UTF16_CHAR_T **const LIBUTF16_RESTRICT w,
+	utf8_char_t **const LIBUTF16_RESTRICT b,
+	const size_t n, const int shrink)
+{
+	utf8_char_t *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	buf = (utf8_char_t*)utf_alloc_buf(UTF16_TO_UTF8_MAX(n), sizeof(*buf));
+	if (!buf)
+		return (size_t)-1; /* not enough memory */
+	d = buf;
+	/* the output buffer is large enough, so the conversion may only fail on invalid input */
+	m = UTF_FORM_NAME(_)(w, &d, UTF16_TO_UTF8_MAX(n), n, /*determ_size:*/0);
+	if (!m) {
+		free(buf);
+		return 0; /* invalid utf16 string */
+	}
+	if (shrink && m < UTF16_TO_UTF8_MAX(n))
+		buf = (utf8_char_t*)utf_shrink_buf(buf, m*sizeof(*buf));
+	*b = buf;
+	return m;
+}
+
+/*
+ utf16_to_utf8_arena
+ utf16x_to_utf8_arena
+ utf16u_to_utf8_arena
+ utf16ux_to_utf8_arena
+*/
+size_t UTF_FORM_NAME(_arena)(
+	const UTF16_CHAR_T **const LIBUTF16_RESTRICT w,
+	utf8_char_t **const LIBUTF16_RESTRICT b,
+	const size_t n, utf_arena_t *const LIBUTF16_RESTRICT a)
+{
+	utf8_char_t *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	if (n <= a->chunk_size/sizeof(*buf)/UTF16_TO_UTF8_MAX(1)) {
+		/* worst-case size fits in a chunk: allocate it and then return unused tail to the arena */
+		buf = (utf8_char_t*)utf_arena_alloc(a, UTF16_TO_UTF8_MAX(n)*sizeof(*buf));
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		/* the output buffer is large enough, so the conversion may only fail on invalid input */
+		m = UTF_FORM_NAME(_)(w, &d, UTF16_TO_UTF8_MAX(n), n, /*determ_size:*/0);
+		utf_arena_trim(a, m ? d : buf);
+		if (!m)
+			return 0; /* invalid utf16 string */
+	}
+	else {
+		/* long string: determine exact size of the output buffer, then convert without validating again */
+		utf_valid_token_t t;
+		m = UTF_FORM_NAME(_size_token)(w, n, &t);
+		if (!m)
+			return 0; /* invalid utf16 string */
+		buf = m <= (size_t)-1/sizeof(*buf) ? (utf8_char_t*)utf_arena_alloc(a, m*sizeof(*buf)) : NULL;
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		(void)UTF_FORM_NAME(_from_token)(&t, &d, m);
+		*w = (const UTF16_CHAR_T*)*w + n;
+	}
+	*b = buf;
+	return m;
+}
+
+/*
+ utf16_to_utf8_grow
+ utf16x_to_utf8_grow
+ utf16u_to_utf8_grow
+ utf16ux_to_utf8_grow
+*/
+size_t UTF_FORM_NAME(_grow)(
+	const UTF16_CHAR_T **const LIBUTF16_RESTRICT w,
+	utf_grow_buf_t *const LIBUTF16_RESTRICT g,
+	size_t n)
+{
+	const size_t len = g->len;
+	while (n) {
+		if (g->len != g->cap) {
+			const UTF16_CHAR_T *const s = *w;
+			utf8_char_t *const o = (utf8_char_t*)g->buf + g->len;
+			utf8_char_t *d = o;
+			const size_t sz = g->cap - g->len;
+			const size_t m = UTF_FORM_NAME(_)(w, &d, sz, n, /*determ_size:*/0);
+			g->len += (size_t)(d - o);
+			if (!m)
+				return 0; /* invalid/incomplete utf16 character */
+			if (m <= sz)
+				return g->len - len; /* ok, all 'n' utf16_char_t's were converted */
+			/* output buffer is full, continue from the last converted utf16_char_t */
+			n -= (size_t)(*w - s);
+		}
+		/* each of remaining utf16_char_t's produces at least one utf8_char_t */
+		if (!utf_grow_buf(g, n, sizeof(utf8_char_t)))
+			return (size_t)-1; /* not enough memory */
+	}
+	return 0; /* n is zero */
+}
+
+/*
+ utf16_to_utf8_size_token
+ utf16x_to_utf8_size_token
+ utf16u_to_utf8_size_token
+ utf16ux_to_utf8_size_token
+*/
+size_t UTF_FORM_NAME(_size_token)(
+	const UTF16_CHAR_T **const LIBUTF16_RESTRICT w,
+	const size_t n,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const size_t sz = UTF_FORM_NAME(_)(w, /*b:*/NULL, /*sz:*/0, n, /*determ_size:*/1);
+	t->src = sz ? *w : NULL;
+	t->n = sz ? n : 0;
+	t->size = sz;
+	t->kind = sz ? UTF_TOKEN_KIND : 0;
+	return sz;
+}
+
+/*
+ utf16_to_utf8_z_size_token
+ utf16x_to_utf8_z_size_token
+ utf16u_to_utf8_z_size_token
+ utf16ux_to_utf8_z_size_token
+*/
+size_t UTF_FORM_NAME(_z_size_token)(
+	const UTF16_CHAR_T **const LIBUTF16_RESTRICT w,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const UTF16_CHAR_T *const s = *w;
+	const size_t sz = UTF_FORM_NAME(_z_)(w, /*b:*/NULL, /*sz:*/0, /*determ_size:*/2);
+	if (!sz) {
+		t->src = NULL;
+		t->n = 0;
+		t->size = 0;
+		t->kind = 0;
+		return 0; /* invalid utf16 string */
+	}
+	t->src = s;
+	t->n = (size_t)(*w - s);
+	t->size = sz;
+	t->kind = UTF_TOKEN_KIND;
+	*w = s; /* (*w) was moved beyond the 0-terminator */
+	return sz;
+}
+
+/*
+ utf16_to_utf8_from_token
+ utf16x_to_utf8_from_token
+ utf16u_to_utf8_from_token
+ utf16ux_to_utf8_from_token
+*/
+size_t UTF_FORM_NAME(_from_token)(
+	const utf_valid_token_t *const LIBUTF16_RESTRICT t,
+	utf8_char_t **const LIBUTF16_RESTRICT b,
+	const size_t sz)
+{
+	if (t->kind != UTF_TOKEN_KIND)
+		return 0; /* the token is empty or was filled by another conversion */
+	if (t->size > sz)
+		return t->size; /* output buffer is too small */
+#ifdef UTF16_TO_UTF8_AVX2
+	if (libutf16_cpu_features() & UTF_CPU_AVX2) {
+		/* the engine validates the string nearly for free and is faster than the unchecked scalar code */
+		const UTF16_CHAR_T *w = (const UTF16_CHAR_T*)t->src;
+		return UTF_FORM_NAME(_)(&w, b, t->size, t->n, /*determ_size:*/0);
+	}
+#endif
+	UTF_FORM_NAME(_unsafe)((const UTF16_CHAR_T*)t->src, *b, t->n);
+	*b += t->size;
+	return t->size;
+}
+
 /*
  utf16_to_utf8_z_unsafe
  utf16x_to_utf8_z_unsafe
@@ -446,6 +1176,11 @@ void UTF_FORM_NAME(_unsafe)(
 			b[-2] = (utf8_char_t)(c >> 6);
 			c = (c & 0x3F) + 0x80;
 		}
+		else if ((size_t)(we - w) > 4 && UTF16_GET(w) < 0x80) {
+			*b++ = (utf8_char_t)c;
+			w = utf16_to_utf8_ascii(w, we, &b, b + (we - w));
+			continue; /* (w != we) */
+		}
 		else
 			b++;
 		b[-1] = (utf8_char_t)c;
@@ -0,0 +1,164 @@
+/**********************************************************************************
+* UTF-16 strings validation
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf16_validate.c */
+
+#include <stddef.h> /* for size_t */
+
+#ifndef _MSC_VER
+#include <stdint.h> /* for uint16_t */
+#endif
+
+#ifdef _MSC_VER
+#include <stdlib.h> /* for _byteswap_ushort()/_byteswap_ulong() */
+#endif
+
+#include <memory.h> /* for memcpy() */
+
+#include "libutf16/utf16_validate.h"
+#include "libutf16/utf16_swap.h"
+
+#include "utf16_internal.h"
+#include "utf16_simd.h"
+#include "utf16_swar.h"
+
+#ifdef _MSC_VER
+#pragma warning(disable:5045) /* Compiler will insert Spectre mitigation for memory load if /Qspectre switch specified */
+#endif
+
+#ifdef UTF_GET_UNALIGNED
+#define UTF16_CHAR_T utf16_char_unaligned_t
+#else
+#define UTF16_CHAR_T utf16_char_t
+#endif
+
+#define UTF_FORM_NAME2(fu, fx, suffix)  utf16##fu##fx##_validate##suffix
+#define UTF_FORM_NAME1(fu, fx, suffix)  UTF_FORM_NAME2(fu, fx, suffix)
+#define UTF_FORM_NAME(suffix)           UTF_FORM_NAME1(UTF_GET_U, UTF16_X, suffix)
+
+#ifdef LIBUTF16_AVX2
+
+/* load 16 utf16_char_t's */
+UTF_TARGET_AVX2
+static inline __m256i utf16_validate_avx2_load(const UTF16_CHAR_T *const s)
+{
+#ifdef SWAP_UTF16
+	return _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)s), _mm256_setr_epi8(
+		1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+#else
+	return _mm256_loadu_si256((const __m256i*)s);
+#endif
+}
+
+/* AVX2 engine: validate blocks of 16 utf16_char_t's, while more than 16 utf16_char_t's remain in the input:
+ - stops before a block containing invalid utf16 character, so the scalar code reports it at exact position,
+ - leaves at least one utf16_char_t, the last validated utf16 character is complete.
+ returns pointer beyond the last validated utf16_char_t */
+UTF_TARGET_AVX2
+static const UTF16_CHAR_T *utf16_validate_avx2(const UTF16_CHAR_T *s, const UTF16_CHAR_T *const se)
+{
+	unsigned hc = 0; /* 3 if the previous block ends with a high surrogate */
+	while ((size_t)(se - s) > 16) {
+		unsigned lo;
+		if (!utf16_avx2_check(utf16_validate_avx2_load(s), &hc, &lo))
+			break; /* invalid utf16 character */
+		s += 16;
+	}
+	if (hc)
+		s--; /* leave the high surrogate at the end of the last validated block for the scalar code */
+	return s;
+}
+
+/* size of a window, in which the terminating 0 is searched before validating its part by the engine */
+#define UTF16_Z_WINDOW 2048
+
+/* AVX2 engine for 0-terminated utf16 string: validate its part before the terminating 0 */
+UTF_TARGET_AVX2
+static const UTF16_CHAR_T *utf16_validate_z_avx2(const UTF16_CHAR_T *s)
+{
+	const UTF16_CHAR_T *z = s;
+	for (;;) {
+		const UTF16_CHAR_T *const p = z + UTF16_Z_WINDOW;
+		z += utf_avx2_find0(z, UTF16_Z_WINDOW, sizeof(*z));
+		s = utf16_validate_avx2(s, z);
+		if (z != p || (size_t)(z - s) > 17)
+			return s; /* 0 was found or the engine has stopped before invalid utf16 character */
+	}
+}
+
+#endif /* LIBUTF16_AVX2 */
+
+/*
+ utf16_validate_z
+ utf16x_validate_z
+ utf16u_validate_z
+ utf16ux_validate_z
+*/
+int UTF_FORM_NAME(_z)(
+	const UTF16_CHAR_T **const q/*in,out,!=NULL*/)
+{
+	const UTF16_CHAR_T *s = *q;
+#ifdef LIBUTF16_AVX2
+	if (libutf16_cpu_features() & UTF_CPU_AVX2)
+		s = utf16_validate_z_avx2(s);
+#endif
+	for (;; s++) {
+		const unsigned c = UTF16_GET(s);
+		if (0xD800 == (c & 0xF800)) {
+			/* high surrogate must be followed by a low one */
+			if (c >= 0xDC00 || 0xDC00 != (UTF16_GET(s + 1) & 0xFC00))
+				break; /* invalid utf16 character */
+			s++;
+		}
+		else if (!c) {
+			*q = s + 1; /* points beyond the 0-terminator */
+			return 1;
+		}
+	}
+	*q = s; /* (*q) points to invalid utf16 character */
+	return 0;
+}
+
+/*
+ utf16_validate
+ utf16x_validate
+ utf16u_validate
+ utf16ux_validate
+*/
+int UTF_FORM_NAME()(
+	const UTF16_CHAR_T **const q/*in,out,!=NULL if n>0*/,
+	const size_t n/*0?*/)
+{
+	if (n) {
+		const UTF16_CHAR_T *s = *q;
+		const UTF16_CHAR_T *const se = s + n;
+#ifdef LIBUTF16_AVX2
+		if (n > 16 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+			s = utf16_validate_avx2(s, se);
+#endif
+		do {
+			unsigned c;
+			/* skip a run of non-surrogate characters, 4 utf16_char_t's at a time */
+			while ((size_t)(se - s) >= 4 && !utf16_swar_has_surrogate(utf_load64(s)))
+				s += 4;
+			if (s == se)
+				break;
+			c = UTF16_GET(s);
+			if (0xD800 == (c & 0xF800)) {
+				/* high surrogate must be followed by a low one */
+				if (c >= 0xDC00 || (size_t)(se - s) < 2 || 0xDC00 != (UTF16_GET(s + 1) & 0xFC00)) {
+					*q = s; /* (*q) < se */
+					return 0; /* invalid utf16 character */
+				}
+				s += 2;
+			}
+			else
+				s++;
+		} while (s != se);
+		*q = se;
+	}
+	return 1;
+}
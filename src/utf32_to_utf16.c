@@ -22,6 +22,8 @@
 #include "libutf16/utf16_swap.h"
 
 #include "utf16_internal.h"
+#include "utf16_simd.h"
+#include "utf16_swar.h"
 
 #ifdef _MSC_VER
 #pragma warning(disable:5045) /* Compiler will insert Spectre mitigation for memory load if /Qspectre switch specified */
@@ -43,6 +45,203 @@
 #define UTF_FORM_NAME1(fu, fx, tu, tx, suffix)  UTF_FORM_NAME2(fu, fx, tu, tx, suffix)
 #define UTF_FORM_NAME(suffix)                   UTF_FORM_NAME1(UTF_GET_U, UTF32_X, UTF_PUT_U, UTF16_X, suffix)
 
+/* kind of tokens of validated strings, filled and accepted by this form of conversion */
+#define UTF_TOKEN_KIND (UTF_TOKEN_UTF32_TO_UTF16 | UTF32_TOKEN_X | UTF_TOKEN_GET_U)
+
+#ifdef LIBUTF16_AVX2
+#define UTF32_TO_UTF16_AVX2
+
+/* load 8 utf32_char_t's */
+UTF_TARGET_AVX2
+static inline __m256i utf32_to_utf16_avx2_load(const UTF32_CHAR_T *const s)
+{
+#ifdef SWAP_UTF32
+	return _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)s), _mm256_setr_epi8(
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+#else
+	return _mm256_loadu_si256((const __m256i*)s);
+#endif
+}
+
+/* swap bytes of 16-bit lanes, if needed */
+UTF_TARGET_AVX2
+static inline __m256i utf32_to_utf16_avx2_out(const __m256i v)
+{
+#ifdef SWAP_UTF16
+	return _mm256_shuffle_epi8(v, _mm256_setr_epi8(
+		1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+#else
+	return v;
+#endif
+}
+
+/* AVX2 engine: validate and convert blocks of 8 (or 16 BMP) utf32_char_t's,
+  while at least 32 utf32_char_t's remain in the input and there is a space for more than 16 utf16_char_t's:
+ - blocks of BMP characters are narrowed by the saturating pack,
+ - in other blocks, each character is expanded to a 32-bit lane holding 1 or 2 utf16_char_t's,
+  then unused halves of lanes are removed by the shuffle,
+ - stops at invalid utf32 character, so the scalar code reports it at exact position,
+ - may store up to 7 garbage utf16_char_t's beyond the (*b), they are overwritten while converting
+  remaining (at least 24) utf32_char_t's.
+ returns pointer beyond the last converted utf32_char_t, updates (*b) */
+UTF_TARGET_AVX2
+static const UTF32_CHAR_T *utf32_to_utf16_avx2(
+	const UTF32_CHAR_T *s, const UTF32_CHAR_T *const se,
+	UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	UTF16_CHAR_T *d = *b;
+	while ((size_t)(se - s) >= 32 && (size_t)(e - (const UTF16_CHAR_T*)d) > 16) {
+		const __m256i c = utf32_to_utf16_avx2_load(s);
+		const __m256i c1 = utf32_to_utf16_avx2_load(s + 8);
+		/* characters >= 0xD800 */
+		const __m256i h = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0xD7FF));
+		if (_mm256_testz_si256(_mm256_or_si256(h, _mm256_cmpgt_epi32(c1, _mm256_set1_epi32(0xD7FF))),
+				_mm256_set1_epi32(-1)) && /* unsigned: characters >= 0x80000000 are negative */
+			_mm256_testz_si256(_mm256_or_si256(c, c1), _mm256_set1_epi32((int)0x80000000)))
+		{
+			/* all 16 characters are < 0xD800 */
+			_mm256_storeu_si256((__m256i*)d,
+				utf32_to_utf16_avx2_out(_mm256_permute4x64_epi64(_mm256_packus_epi32(c, c1), 0xD8)));
+			s += 16;
+			d += 16;
+		}
+		else {
+			/* 0x10FFFF < c or 0xD800 <= c <= 0xDFFF */
+			const unsigned bad = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(
+				_mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_min_epu32(c, _mm256_set1_epi32(0x10FFFF)), c), _mm256_set1_epi32(-1)),
+				_mm256_cmpeq_epi32(_mm256_and_si256(c, _mm256_set1_epi32((int)0xFFFFF800)), _mm256_set1_epi32(0xD800)))));
+			const unsigned n = bad ? utf_bsf32(bad) : 8;
+			if (!n)
+				break; /* invalid utf32 character */
+			{
+				/* characters > 0xFFFF: 0xD7C0 + (c >> 10) | (0xDC00 + (c & 0x3FF)) << 16 */
+				const __m256i g = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0xFFFF));
+				const __m256i v = utf32_to_utf16_avx2_out(_mm256_blendv_epi8(c,
+					_mm256_or_si256(
+						_mm256_add_epi32(_mm256_srli_epi32(c, 10), _mm256_set1_epi32(0xD7C0)),
+						_mm256_slli_epi32(_mm256_or_si256(_mm256_and_si256(c, _mm256_set1_epi32(0x3FF)), _mm256_set1_epi32(0xDC00)), 16)),
+					g));
+				/* masks of utf16_char_t's to store: low halves of all lanes, high halves - of lanes > 0xFFFF,
+				  8 bits per 128-bit lane: in bits 0-7 and 16-23 */
+				unsigned k = (unsigned)_mm256_movemask_epi8(_mm256_packs_epi16(
+					_mm256_or_si256(_mm256_and_si256(g, _mm256_set1_epi32((int)0xFFFF0000)), _mm256_set1_epi32(0xFFFF)),
+					_mm256_setzero_si256()));
+				if (n < 8) {
+					/* only characters before invalid one */
+					const unsigned r = (1u << 2*n) - 1;
+					k &= (r & 0xFF) | ((r & 0xFF00) << 8);
+				}
+				{
+					const __m256i p = _mm256_shuffle_epi8(v, _mm256_inserti128_si256(_mm256_castsi128_si256(
+						_mm_loadu_si128((const __m128i*)libutf16_pack16_shuf[k & 0xFF])),
+						_mm_loadu_si128((const __m128i*)libutf16_pack16_shuf[(k >> 16) & 0xFF]), 1));
+					_mm_storeu_si128((__m128i*)d, _mm256_castsi256_si128(p));
+					d += utf_popcnt32(k & 0xFF);
+					_mm_storeu_si128((__m128i*)d, _mm256_extracti128_si256(p, 1));
+					d += utf_popcnt32(k >> 16);
+				}
+			}
+			s += n;
+			if (n < 8)
+				break;
+		}
+	}
+	*b = d;
+	return s;
+}
+
+/* size of a window, in which the terminating 0 is searched before converting its part by the AVX2 engine */
+#define UTF32_Z_WINDOW 1024
+
+/* AVX2 engine for 0-terminated utf32 string: convert its parts known not to contain the terminating 0 */
+UTF_TARGET_AVX2
+static const UTF32_CHAR_T *utf32_to_utf16_z_avx2(
+	const UTF32_CHAR_T *s, UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	const UTF32_CHAR_T *z = s;
+	for (;;) {
+		const UTF32_CHAR_T *const p = z + UTF32_Z_WINDOW;
+		z += utf_avx2_find0(z, UTF32_Z_WINDOW, sizeof(*z));
+		s = utf32_to_utf16_avx2(s, z, b, e);
+		if (z != p || (size_t)(z - s) >= 32)
+			return s; /* 0 was found or the engine has stopped not because of the window end */
+	}
+}
+
+/* AVX2 engine of the size-only pass: validate blocks of 8 utf32_char_t's while at least 8 of them remain,
+  stops before a block containing invalid utf32 character, so the scalar code reports it at exact position,
+  adds to (*pm) the number of validated utf32_char_t's converted to surrogate pairs,
+  returns pointer beyond the last validated utf32_char_t */
+UTF_TARGET_AVX2
+static const UTF32_CHAR_T *utf32_to_utf16_size_avx2(
+	const UTF32_CHAR_T *s, const UTF32_CHAR_T *const se, size_t *const pm)
+{
+	size_t m = 0;
+	while ((size_t)(se - s) >= 8) {
+		const __m256i c = utf32_to_utf16_avx2_load(s);
+		if (!_mm256_testz_si256(c, _mm256_set1_epi32((int)0xFFFFFF80))) {
+			if (!utf32_avx2_valid(c))
+				break; /* invalid utf32 character */
+			/* + 1 for characters converted to surrogate pairs */
+			m += utf_popcnt32(
+				(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(c, _mm256_set1_epi32(0xFFFF)))));
+		}
+		s += 8;
+	}
+	*pm += m;
+	return s;
+}
+
+/* AVX2 engine of the size-only pass for 0-terminated utf32 string: validate its part before the terminating 0 */
+UTF_TARGET_AVX2
+static const UTF32_CHAR_T *utf32_to_utf16_z_size_avx2(const UTF32_CHAR_T *s, size_t *const pm)
+{
+	const UTF32_CHAR_T *z = s;
+	for (;;) {
+		const UTF32_CHAR_T *const p = z + UTF32_Z_WINDOW;
+		z += utf_avx2_find0(z, UTF32_Z_WINDOW, sizeof(*z));
+		s = utf32_to_utf16_size_avx2(s, z, pm);
+		if (z != p || (size_t)(z - s) >= 8)
+			return s; /* 0 was found or the engine has stopped before invalid utf32 character */
+	}
+}
+
+#endif /* LIBUTF16_AVX2 */
+
+/* convert a run of non-surrogate BMP characters, 4 utf32_char_t's at a time,
+  there must be more than 4 utf32_char_t's in the source buffer and more than 4 free utf16_char_t's in the destination,
+  returns pointer to the first non-converted utf32_char_t, at least one utf32_char_t and one free utf16_char_t are left */
+static const UTF32_CHAR_T *utf32_to_utf16_bmp(
+	const UTF32_CHAR_T *s, const UTF32_CHAR_T *const se,
+	UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	UTF16_CHAR_T *d = *b;
+	size_t n = (size_t)(se - s);
+	if (n > (size_t)(e - (const UTF16_CHAR_T*)d))
+		n = (size_t)(e - (const UTF16_CHAR_T*)d);
+	do {
+		const utf_word64_t w[2] = {utf_load64(s), utf_load64(s + 2)};
+		UTF32_CHAR_T c[4];
+		unsigned i = 0;
+		if (utf32_swar_not_bmp(w[0]) || utf32_swar_not_bmp(w[1])) {
+			/* convert characters before the surrogate or the character out of BMP */
+			for (; UTF32_GET(s + i) < 0xD800 || (0xDFFF < UTF32_GET(s + i) && UTF32_GET(s + i) <= 0xFFFF); i++)
+				UTF16_PUT(d + i, (utf16_char_t)UTF32_GET(s + i));
+			s += i;
+			d += i;
+			break;
+		}
+		memcpy(c, w, sizeof(c));
+		for (; i < 4; i++)
+			UTF16_PUT(d + i, (utf16_char_t)UTF32_GET((const UTF32_CHAR_T*)c + i));
+		s += 4;
+		d += 4;
+		n -= 4;
+	} while (n > 4);
+	*b = d;
+	return s;
+}
+
 /*
  utf32_to_utf16_z_
  utf32_to_utf16x_z_
@@ -72,6 +271,10 @@ size_t UTF_FORM_NAME(_z_)(
 	if (sz) {
 		UTF16_CHAR_T *LIBUTF16_RESTRICT d = *b;
 		const UTF16_CHAR_T *const e = (const UTF16_CHAR_T*)d + sz;
+#ifdef UTF32_TO_UTF16_AVX2
+		if (sz > 16 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+			s = utf32_to_utf16_z_avx2(s, &d, e);
+#endif
 		do {
 			unsigned c = UTF32_GET(s++);
 			if (c > 0xFFFF) {
@@ -117,6 +320,10 @@ size_t UTF_FORM_NAME(_z_)(
 	  safely increment 'm' at least by 2 without integer overflow */
 	{
 		const UTF32_CHAR_T *const t = s - m; /* points beyond the last converted non-0 utf32_char_t */
+#ifdef UTF32_TO_UTF16_AVX2
+		if (libutf16_cpu_features() & UTF_CPU_AVX2)
+			s = utf32_to_utf16_z_size_avx2(s, &m);
+#endif
 		for (;;) {
 			unsigned c = UTF32_GET(s++);
 			if (c > 0xFFFF) {
@@ -170,6 +377,10 @@ size_t UTF_FORM_NAME(_)(
 		if (sz) {
 			UTF16_CHAR_T *LIBUTF16_RESTRICT d = *b;
 			const UTF16_CHAR_T *const e = (const UTF16_CHAR_T*)d + sz;
+#ifdef UTF32_TO_UTF16_AVX2
+			if (libutf16_cpu_features() & UTF_CPU_AVX2)
+				s = utf32_to_utf16_avx2(s, se, &d, e);
+#endif
 			do {
 				unsigned c = UTF32_GET(s++);
 				if (c > 0xFFFF) {
@@ -190,6 +401,11 @@ size_t UTF_FORM_NAME(_)(
 					*b = d;
 					return 0; /* must not be a surrogate */
 				}
+				else if ((size_t)(se - s) > 4 && (size_t)(e - (const UTF16_CHAR_T*)d) > 5 && UTF32_GET(s) < 0xD800) {
+					UTF16_PUT(d++, (utf16_char_t)c);
+					s = utf32_to_utf16_bmp(s, se, &d, e);
+					continue; /* (d != e) */
+				}
 				UTF16_PUT(d++, (utf16_char_t)c);
 				if (se == s) {
 					sz = (size_t)(d - *b);
@@ -213,7 +429,11 @@ size_t UTF_FORM_NAME(_)(
 		  safely increment 'm' at least by 2 without integer overflow */
 		{
 			const UTF32_CHAR_T *const t = s - m; /* points beyond the last converted utf32_char_t, t < se */
-			do {
+#ifdef UTF32_TO_UTF16_AVX2
+			if ((size_t)(se - s) >= 8 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+				s = utf32_to_utf16_size_avx2(s, se, &m);
+#endif
+			while (s != se) {
 				unsigned c = UTF32_GET(s++);
 				if (c > 0xFFFF) {
 					if (c > 0x10FFFF) {
@@ -226,7 +446,7 @@ size_t UTF_FORM_NAME(_)(
 					*w = s - 1; /* (*w) < se */
 					return 0; /* must not be a surrogate */
 				}
-			} while (s != se);
+			}
 			sz += m + (size_t)(s - t);
 			*w = t; /* points after the last successfully converted utf32_char_t, (*w) < se */
 			return sz; /* ok, >0, but > dst buffer size */
@@ -235,6 +455,233 @@ size_t UTF_FORM_NAME(_)(
 	return 0; /* n is zero */
 }
 
+#ifndef UTF_PUT_UNALIGNED
+/*
+ utf32_to_utf16_alloc
+ utf32_to_utf16x_alloc
+ utf32x_to_utf16_alloc
+ utf32x_to_utf16x_alloc
+ utf32u_to_utf16_alloc
+ utf32u_to_utf16x_alloc
+ utf32ux_to_utf16_alloc
+ utf32ux_to_utf16x_alloc
+*/
+size_t UTF_FORM_NAME(_alloc)(
+	const UTF32_CHAR_T **const LIBUTF16_RESTRICT w,
+	UTF16_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t n, const int shrink)
+{
+	UTF16_CHAR_T *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	buf = (UTF16_CHAR_T*)utf_alloc_buf(UTF32_TO_UTF16_MAX(n), sizeof(*buf));
+	if (!buf)
+		return (size_t)-1; /* not enough memory */
+	d = buf;
+	/* the output buffer is large enough, so the conversion may only fail on invalid input */
+	m = UTF_FORM_NAME(_)(w, &d, UTF32_TO_UTF16_MAX(n), n, /*determ_size:*/0);
+	if (!m) {
+		free(buf);
+		return 0; /* invalid utf32 string */
+	}
+	if (shrink && m < UTF32_TO_UTF16_MAX(n))
+		buf = (UTF16_CHAR_T*)utf_shrink_buf(buf, m*sizeof(*buf));
+	*b = buf;
+	return m;
+}
+
+/*
+ utf32_to_utf16_arena
+ utf32_to_utf16x_arena
+ utf32x_to_utf16_arena
+ utf32x_to_utf16x_arena
+ utf32u_to_utf16_arena
+ utf32u_to_utf16x_arena
+ utf32ux_to_utf16_arena
+ utf32ux_to_utf16x_arena
+*/
+size_t UTF_FORM_NAME(_arena)(
+	const UTF32_CHAR_T **const LIBUTF16_RESTRICT w,
+	UTF16_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t n, utf_arena_t *const LIBUTF16_RESTRICT a)
+{
+	UTF16_CHAR_T *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	if (n <= a->chunk_size/sizeof(*buf)/UTF32_TO_UTF16_MAX(1)) {
+		/* worst-case size fits in a chunk: allocate it and then return unused tail to the arena */
+		buf = (UTF16_CHAR_T*)utf_arena_alloc(a, UTF32_TO_UTF16_MAX(n)*sizeof(*buf));
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		/* the output buffer is large enough, so the conversion may only fail on invalid input */
+		m = UTF_FORM_NAME(_)(w, &d, UTF32_TO_UTF16_MAX(n), n, /*determ_size:*/0);
+		utf_arena_trim(a, m ? d : buf);
+		if (!m)
+			return 0; /* invalid utf32 string */
+	}
+	else {
+		/* long string: determine exact size of the output buffer, then convert without validating again */
+		utf_valid_token_t t;
+		m = UTF_FORM_NAME(_size_token)(w, n, &t);
+		if (!m)
+			return 0; /* invalid utf32 string */
+		buf = m <= (size_t)-1/sizeof(*buf) ? (UTF16_CHAR_T*)utf_arena_alloc(a, m*sizeof(*buf)) : NULL;
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		(void)UTF_FORM_NAME(_from_token)(&t, &d, m);
+		*w = (const UTF32_CHAR_T*)*w + n;
+	}
+	*b = buf;
+	return m;
+}
+
+/*
+ utf32_to_utf16_grow
+ utf32_to_utf16x_grow
+ utf32x_to_utf16_grow
+ utf32x_to_utf16x_grow
+ utf32u_to_utf16_grow
+ utf32u_to_utf16x_grow
+ utf32ux_to_utf16_grow
+ utf32ux_to_utf16x_grow
+*/
+size_t UTF_FORM_NAME(_grow)(
+	const UTF32_CHAR_T **const LIBUTF16_RESTRICT w,
+	utf_grow_buf_t *const LIBUTF16_RESTRICT g,
+	size_t n)
+{
+	const size_t len = g->len;
+	while (n) {
+		if (g->len != g->cap) {
+			const UTF32_CHAR_T *const s = *w;
+			UTF16_CHAR_T *const o = (UTF16_CHAR_T*)g->buf + g->len;
+			UTF16_CHAR_T *d = o;
+			const size_t sz = g->cap - g->len;
+			const size_t m = UTF_FORM_NAME(_)(w, &d, sz, n, /*determ_size:*/0);
+			g->len += (size_t)(d - o);
+			if (!m)
+				return 0; /* invalid/incomplete utf32 character */
+			if (m <= sz)
+				return g->len - len; /* ok, all 'n' utf32_char_t's were converted */
+			/* output buffer is full, continue from the last converted utf32_char_t */
+			n -= (size_t)(*w - s);
+		}
+		/* each of remaining utf32_char_t's produces at least one utf16_char_t */
+		if (!utf_grow_buf(g, n, sizeof(UTF16_CHAR_T)))
+			return (size_t)-1; /* not enough memory */
+	}
+	return 0; /* n is zero */
+}
+#endif
+
+/*
+ utf32_to_utf16_size_token
+ utf32_to_utf16x_size_token
+ utf32_to_utf16u_size_token
+ utf32_to_utf16ux_size_token
+ utf32x_to_utf16_size_token
+ utf32x_to_utf16x_size_token
+ utf32x_to_utf16u_size_token
+ utf32x_to_utf16ux_size_token
+ utf32u_to_utf16_size_token
+ utf32u_to_utf16x_size_token
+ utf32u_to_utf16u_size_token
+ utf32u_to_utf16ux_size_token
+ utf32ux_to_utf16_size_token
+ utf32ux_to_utf16x_size_token
+ utf32ux_to_utf16u_size_token
+ utf32ux_to_utf16ux_size_token
+*/
+size_t UTF_FORM_NAME(_size_token)(
+	const UTF32_CHAR_T **const LIBUTF16_RESTRICT w,
+	const size_t n,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const size_t sz = UTF_FORM_NAME(_)(w, /*b:*/NULL, /*sz:*/0, n, /*determ_size:*/1);
+	t->src = sz ? *w : NULL;
+	t->n = sz ? n : 0;
+	t->size = sz;
+	t->kind = sz ? UTF_TOKEN_KIND : 0;
+	return sz;
+}
+
+/*
+ utf32_to_utf16_z_size_token
+ utf32_to_utf16x_z_size_token
+ utf32_to_utf16u_z_size_token
+ utf32_to_utf16ux_z_size_token
+ utf32x_to_utf16_z_size_token
+ utf32x_to_utf16x_z_size_token
+ utf32x_to_utf16u_z_size_token
+ utf32x_to_utf16ux_z_size_token
+ utf32u_to_utf16_z_size_token
+ utf32u_to_utf16x_z_size_token
+ utf32u_to_utf16u_z_size_token
+ utf32u_to_utf16ux_z_size_token
+ utf32ux_to_utf16_z_size_token
+ utf32ux_to_utf16x_z_size_token
+ utf32ux_to_utf16u_z_size_token
+ utf32ux_to_utf16ux_z_size_token
+*/
+size_t UTF_FORM_NAME(_z_size_token)(
+	const UTF32_CHAR_T **const LIBUTF16_RESTRICT w,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const UTF32_CHAR_T *const s = *w;
+	const size_t sz = UTF_FORM_NAME(_z_)(w, /*b:*/NULL, /*sz:*/0, /*determ_size:*/2);
+	if (!sz) {
+		t->src = NULL;
+		t->n = 0;
+		t->size = 0;
+		t->kind = 0;
+		return 0; /* invalid utf32 string */
+	}
+	t->src = s;
+	t->n = (size_t)(*w - s);
+	t->size = sz;
+	t->kind = UTF_TOKEN_KIND;
+	*w = s; /* (*w) was moved beyond the 0-terminator */
+	return sz;
+}
+
+/*
+ utf32_to_utf16_from_token
+ utf32_to_utf16x_from_token
+ utf32_to_utf16u_from_token
+ utf32_to_utf16ux_from_token
+ utf32x_to_utf16_from_token
+ utf32x_to_utf16x_from_token
+ utf32x_to_utf16u_from_token
+ utf32x_to_utf16ux_from_token
+ utf32u_to_utf16_from_token
+ utf32u_to_utf16x_from_token
+ utf32u_to_utf16u_from_token
+ utf32u_to_utf16ux_from_token
+ utf32ux_to_utf16_from_token
+ utf32ux_to_utf16x_from_token
+ utf32ux_to_utf16u_from_token
+ utf32ux_to_utf16ux_from_token
+*/
+size_t UTF_FORM_NAME(_from_token)(
+	const utf_valid_token_t *const LIBUTF16_RESTRICT t,
+	UTF16_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t sz)
+{
+	const UTF32_CHAR_T *w = (const UTF32_CHAR_T*)t->src;
+	if (t->kind != UTF_TOKEN_KIND)
+		return 0; /* the token is empty or was filled by another conversion */
+	if (t->size > sz)
+		return t->size; /* output buffer is too small */
+	/* validation of utf32 string is cheap, use checked code */
+	return UTF_FORM_NAME(_)(&w, b, t->size, t->n, /*determ_size:*/0);
+}
+
 /*
  utf32_to_utf16_z_unsafe
  utf32_to_utf16x_z_unsafe
@@ -22,6 +22,8 @@
 #include "libutf16/utf16_swap.h"
 
 #include "utf16_internal.h"
+#include "utf16_simd.h"
+#include "utf16_swar.h"
 
 #ifdef _MSC_VER
 #pragma warning(disable:5045) /* Compiler will insert Spectre mitigation for memory load if /Qspectre switch specified */
@@ -37,6 +39,380 @@
 #define UTF_FORM_NAME1(fu, fx, suffix)  UTF_FORM_NAME2(fu, fx, suffix)
 #define UTF_FORM_NAME(suffix)           UTF_FORM_NAME1(UTF_GET_U, UTF32_X, suffix)
 
+/* kind of tokens of validated strings, filled and accepted by this form of conversion */
+#define UTF_TOKEN_KIND (UTF_TOKEN_UTF32_TO_UTF8 | UTF32_TOKEN_X | UTF_TOKEN_GET_U)
+
+#ifdef LIBUTF16_AVX512
+#define UTF32_TO_UTF8_AVX512
+
+/* swap bytes of utf32_char_t's loaded by the AVX-512 engine */
+#ifdef SWAP_UTF32
+#define UTF32_AVX512_SWAP(c) _mm512_shuffle_epi8(c, _mm512_set4_epi32(0x0C0D0E0F, 0x08090A0B, 0x04050607, 0x00010203))
+#else
+#define UTF32_AVX512_SWAP(c) (c)
+#endif
+
+/* AVX-512 engine: validate and convert a block of l (1..16) utf32_char_t's, lanes of c beyond the l-th are zero,
+  fill - the input ends with the block and the output buffer may be filled completely,
+  else there must remain a space for at least one utf8_char_t after the converted ones.
+  Uses masked stores, so writes nothing beyond the converted utf8_char_t's.
+  Returns number of converted utf32_char_t's, 0 if the block starts with invalid utf32 character
+  or there is not enough space in the output buffer, updates (*pd) */
+UTF_TARGET_AVX512
+static UTF_FORCE_INLINE unsigned utf32_to_utf8_avx512_block(const __m512i c, const unsigned l,
+	utf8_char_t **const pd, const utf8_char_t *const e, const int fill)
+{
+	const size_t room = (size_t)(e - *pd);
+	if (!_mm512_cmpgt_epu32_mask(c, _mm512_set1_epi32(0x7F))) {
+		if (l >= room + !!fill)
+			return 0; /* not enough space in the output buffer */
+		_mm512_mask_cvtepi32_storeu_epi8(*pd, (__mmask16)_bzhi_u32(0xFFFF, l), c);
+		*pd += l;
+		return l;
+	}
+	{
+		/* 0x10FFFF < c or 0xD800 <= c <= 0xDFFF */
+		const unsigned bad = (unsigned)(__mmask16)(
+			_mm512_cmpgt_epu32_mask(c, _mm512_set1_epi32(0x10FFFF)) |
+			_mm512_cmpeq_epi32_mask(_mm512_and_si512(c, _mm512_set1_epi32((int)0xFFFFF800)), _mm512_set1_epi32(0xD800)));
+		const unsigned n = bad ? utf_bsf32(bad) : l;
+		__mmask64 keep;
+		__m512i v;
+		unsigned k;
+		if (!n)
+			return 0; /* invalid utf32 character */
+		v = utf8_avx512_encode(c, (__mmask16)_bzhi_u32(0xFFFF, n), &keep);
+		k = utf_popcnt64(keep);
+		if (k >= room + (fill && n == l))
+			return 0; /* not enough space in the output buffer */
+		_mm512_mask_storeu_epi8(*pd, _bzhi_u64(~0ull, k), _mm512_maskz_compress_epi8(keep, v));
+		*pd += k;
+		return n;
+	}
+}
+
+/* AVX-512 engine: validate and convert blocks of 16 utf32_char_t's, the last block is read by a masked load:
+ - stops at invalid utf32 character, so the scalar code reports it at exact position,
+ - stops if there is not enough space in the output buffer for the next block,
+ - if not all utf32_char_t's are converted, leaves a space for at least one utf8_char_t in the output buffer.
+ returns pointer beyond the last converted utf32_char_t, updates (*b) */
+UTF_TARGET_AVX512
+static const UTF32_CHAR_T *utf32_to_utf8_avx512(
+	const UTF32_CHAR_T *s, const UTF32_CHAR_T *const se,
+	utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	utf8_char_t *d = *b;
+	do {
+		const size_t k = (size_t)(se - s);
+		const unsigned l = k < 16 ? (unsigned)k : 16u;
+		unsigned n;
+		if (k > 32 && (size_t)(e - d) > 32) {
+			const __m512i c = UTF32_AVX512_SWAP(_mm512_loadu_si512(s));
+			const __m512i c1 = UTF32_AVX512_SWAP(_mm512_loadu_si512(s + 16));
+			if (!_mm512_cmpgt_epu32_mask(_mm512_or_si512(c, c1), _mm512_set1_epi32(0x7F))) {
+				/* fast path for 32 characters < 0x80 */
+				_mm_storeu_si128((__m128i*)d, _mm512_cvtepi32_epi8(c));
+				_mm_storeu_si128((__m128i*)d + 1, _mm512_cvtepi32_epi8(c1));
+				s += 32;
+				d += 32;
+				continue;
+			}
+		}
+		n = utf32_to_utf8_avx512_block(
+			UTF32_AVX512_SWAP(_mm512_maskz_loadu_epi32((__mmask16)_bzhi_u32(0xFFFF, l), s)), l, &d, e, k <= 16);
+		s += n;
+		if (n != 16)
+			break; /* stopped or converted the last block */
+	} while (s != se);
+	*b = d;
+	return s;
+}
+
+/* AVX-512 engine for 0-terminated utf32 string: convert its part before the terminating 0,
+  never reading memory beyond the page containing the terminating 0,
+  leaves a space for at least one utf8_char_t in the output buffer */
+UTF_TARGET_AVX512
+static const UTF32_CHAR_T *utf32_to_utf8_z_avx512(
+	const UTF32_CHAR_T *s, utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	utf8_char_t *d = *b;
+	for (;;) {
+		__m512i c = utf_avx512_load_z(s, sizeof(*s));
+		const __mmask16 z = _mm512_testn_epi32_mask(c, c);
+		unsigned l = 16, n;
+		if (z) {
+			l = utf_bsf32(z);
+			if (!l)
+				break; /* the terminating 0 */
+			c = _mm512_maskz_mov_epi32((__mmask16)_bzhi_u32(0xFFFF, l), c);
+		}
+		n = utf32_to_utf8_avx512_block(UTF32_AVX512_SWAP(c), l, &d, e, /*fill:*/0);
+		s += n;
+		if (n != 16)
+			break; /* invalid utf32 character, not enough space in the output buffer or the terminating 0 is reached */
+	}
+	*b = d;
+	return s;
+}
+
+/* minimal length of utf32 string for the AVX-512 engine, shorter strings are faster converted by the scalar code */
+#define UTF32_AVX512_MIN 4
+
+#endif /* LIBUTF16_AVX512 */
+
+#ifdef LIBUTF16_AVX2
+#define UTF32_TO_UTF8_AVX2
+
+/* load 8 utf32_char_t's */
+UTF_TARGET_AVX2
+static inline __m256i utf32_to_utf8_avx2_load(const UTF32_CHAR_T *const s)
+{
+#ifdef SWAP_UTF32
+	return _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)s), _mm256_setr_epi8(
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+#else
+	return _mm256_loadu_si256((const __m256i*)s);
+#endif
+}
+
+/* AVX2 engine: validate and convert blocks of 8 (or 16 one-byte) utf32_char_t's,
+  while at least 64 utf32_char_t's remain in the input and there are at least 64 bytes in the output buffer:
+ - each character is encoded in its 32-bit lane, then lanes are compacted by the shuffle
+  indexed by the lengths of encoded characters,
+ - stops at invalid utf32 character, so the scalar code reports it at exact position,
+ - may store up to 12 garbage bytes beyond the (*b), they are overwritten while converting
+  remaining (at least 56) utf32_char_t's.
+ returns pointer beyond the last converted utf32_char_t, updates (*b) */
+UTF_TARGET_AVX2
+static const UTF32_CHAR_T *utf32_to_utf8_avx2(
+	const UTF32_CHAR_T *s, const UTF32_CHAR_T *const se,
+	utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	utf8_char_t *d = *b;
+	while ((size_t)(se - s) >= 64 && (size_t)(e - d) >= 64) {
+		const __m256i c = utf32_to_utf8_avx2_load(s);
+		const __m256i c1 = utf32_to_utf8_avx2_load(s + 8);
+		if (_mm256_testz_si256(_mm256_or_si256(c, c1), _mm256_set1_epi32((int)0xFFFFFF80))) {
+			/* all 16 characters are < 0x80 */
+			const __m256i w = _mm256_permute4x64_epi64(_mm256_packus_epi32(c, c1), 0xD8);
+			_mm_storeu_si128((__m128i*)d, _mm_packus_epi16(_mm256_castsi256_si128(w), _mm256_extracti128_si256(w, 1)));
+			s += 16;
+			d += 16;
+		}
+		else {
+			/* 0x10FFFF < c or 0xD800 <= c <= 0xDFFF */
+			const unsigned bad = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_or_si256(
+				_mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_min_epu32(c, _mm256_set1_epi32(0x10FFFF)), c), _mm256_set1_epi32(-1)),
+				_mm256_cmpeq_epi32(_mm256_and_si256(c, _mm256_set1_epi32((int)0xFFFFF800)), _mm256_set1_epi32(0xD800)))));
+			const unsigned n = bad ? utf_bsf32(bad) : 8;
+			if (!n)
+				break; /* invalid utf32 character */
+			{
+				const __m256i g1 = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0x7F));
+				const __m256i g2 = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0x7FF));
+				const __m256i g3 = _mm256_cmpgt_epi32(c, _mm256_set1_epi32(0xFFFF));
+				const __m256i t = _mm256_or_si256(_mm256_and_si256(c, _mm256_set1_epi32(0x3F)), _mm256_set1_epi32(0x80));
+				const __m256i t6 = _mm256_or_si256(
+					_mm256_and_si256(_mm256_srli_epi32(c, 6), _mm256_set1_epi32(0x3F)), _mm256_set1_epi32(0x80));
+				const unsigned m2 = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(g2));
+				const unsigned m3 = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(g3));
+				unsigned l, m1;
+				/* 00000aaaaabbbbbb -> 110aaaaa 10bbbbbb */
+				__m256i v = _mm256_blendv_epi8(c,
+					_mm256_or_si256(_mm256_or_si256(_mm256_srli_epi32(c, 6), _mm256_set1_epi32(0xC0)), _mm256_slli_epi32(t, 8)), g1);
+				if (m2) {
+					/* aaaabbbbbbcccccc -> 1110aaaa 10bbbbbb 10cccccc */
+					v = _mm256_blendv_epi8(v,
+						_mm256_or_si256(
+							_mm256_or_si256(_mm256_srli_epi32(c, 12), _mm256_set1_epi32(0xE0)),
+							_mm256_or_si256(_mm256_slli_epi32(t6, 8), _mm256_slli_epi32(t, 16))), g2);
+					if (m3) {
+						/* aaabbbbbbccccccdddddd -> 11110aaa 10bbbbbb 10cccccc 10dddddd */
+						v = _mm256_blendv_epi8(v,
+							_mm256_or_si256(
+								_mm256_or_si256(_mm256_srli_epi32(c, 18), _mm256_set1_epi32(0xF0)),
+								_mm256_or_si256(
+									_mm256_slli_epi32(_mm256_or_si256(
+										_mm256_and_si256(_mm256_srli_epi32(c, 12), _mm256_set1_epi32(0x3F)), _mm256_set1_epi32(0x80)), 8),
+									_mm256_or_si256(_mm256_slli_epi32(t6, 16), _mm256_slli_epi32(t, 24)))), g3);
+					}
+				}
+				/* lengths of characters minus one, 2 bits per lane: bits 7 and 15 of 16-bit lanes */
+				{
+					const __m256i k = _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_add_epi32(_mm256_add_epi32(g1, g2), g3));
+					l = (unsigned)_mm256_movemask_epi8(_mm256_packus_epi32(
+						_mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(k, _mm256_set1_epi32(1)), 7),
+							_mm256_slli_epi32(_mm256_and_si256(k, _mm256_set1_epi32(2)), 14)), _mm256_setzero_si256()));
+				}
+				v = _mm256_shuffle_epi8(v, _mm256_inserti128_si256(_mm256_castsi128_si256(
+					_mm_loadu_si128((const __m128i*)libutf16_utf8_pack32_len_shuf[l & 0xFF])),
+					_mm_loadu_si128((const __m128i*)libutf16_utf8_pack32_len_shuf[(l >> 16) & 0xFF]), 1));
+				m1 = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(g1));
+				if (n == 8) {
+					_mm_storeu_si128((__m128i*)d, _mm256_castsi256_si128(v));
+					d += 4 + utf_popcnt32((m1 & 0xF) | (m2 & 0xF) << 4 | (m3 & 0xF) << 8);
+					_mm_storeu_si128((__m128i*)d, _mm256_extracti128_si256(v, 1));
+					d += 4 + utf_popcnt32((m1 >> 4) | (m2 >> 4) << 4 | (m3 >> 4) << 8);
+					s += 8;
+				}
+				else {
+					/* store characters before invalid one */
+					const unsigned r = (1u << n) - 1;
+					_mm_storeu_si128((__m128i*)d, _mm256_castsi256_si128(v));
+					if (n > 4)
+						_mm_storeu_si128((__m128i*)(d + 4 + utf_popcnt32((m1 & 0xF) | (m2 & 0xF) << 4 | (m3 & 0xF) << 8)),
+							_mm256_extracti128_si256(v, 1));
+					d += n + utf_popcnt32(m1 & r) + utf_popcnt32(m2 & r) + utf_popcnt32(m3 & r);
+					s += n;
+					break;
+				}
+			}
+		}
+	}
+	*b = d;
+	return s;
+}
+
+/* size of a window, in which the terminating 0 is searched before converting its part by the AVX2 engine */
+#define UTF32_Z_WINDOW 1024
+
+/* AVX2 engine for 0-terminated utf32 string: convert its parts known not to contain the terminating 0 */
+UTF_TARGET_AVX2
+static const UTF32_CHAR_T *utf32_to_utf8_z_avx2(
+	const UTF32_CHAR_T *s, utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	const UTF32_CHAR_T *z = s;
+	for (;;) {
+		const UTF32_CHAR_T *const p = z + UTF32_Z_WINDOW;
+		z += utf_avx2_find0(z, UTF32_Z_WINDOW, sizeof(*z));
+		s = utf32_to_utf8_avx2(s, z, b, e);
+		if (z != p || (size_t)(z - s) >= 64)
+			return s; /* 0 was found or the engine has stopped not because of the window end */
+	}
+}
+
+/* AVX2 engine of the size-only pass: validate blocks of 8 utf32_char_t's while at least 8 of them remain,
+  stops before a block containing invalid utf32 character, so the scalar code reports it at exact position,
+  adds to (*pm) the number of utf8_char_t's the validated utf32_char_t's are converted to, minus their number,
+  returns pointer beyond the last validated utf32_char_t */
+UTF_TARGET_AVX2
+static const UTF32_CHAR_T *utf32_to_utf8_size_avx2(
+	const UTF32_CHAR_T *s, const UTF32_CHAR_T *const se, size_t *const pm)
+{
+	size_t m = 0;
+	while ((size_t)(se - s) >= 8) {
+		const __m256i c = utf32_to_utf8_avx2_load(s);
+		if (!_mm256_testz_si256(c, _mm256_set1_epi32((int)0xFFFFFF80))) {
+			if (!utf32_avx2_valid(c))
+				break; /* invalid utf32 character */
+			/* + 1 for characters >= 0x80, + 1 for characters >= 0x800, + 1 for characters >= 0x10000 */
+			m += utf_popcnt32(
+				(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(c, _mm256_set1_epi32(0x7F))))) +
+				utf_popcnt32(
+				(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(c, _mm256_set1_epi32(0x7FF))))) +
+				utf_popcnt32(
+				(unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(c, _mm256_set1_epi32(0xFFFF)))));
+		}
+		s += 8;
+	}
+	*pm += m;
+	return s;
+}
+
+/* AVX2 engine of the size-only pass for 0-terminated utf32 string: validate its part before the terminating 0 */
+UTF_TARGET_AVX2
+static const UTF32_CHAR_T *utf32_to_utf8_z_size_avx2(const UTF32_CHAR_T *s, size_t *const pm)
+{
+	const UTF32_CHAR_T *z = s;
+	for (;;) {
+		const UTF32_CHAR_T *const p = z + UTF32_Z_WINDOW;
+		z += utf_avx2_find0(z, UTF32_Z_WINDOW, sizeof(*z));
+		s = utf32_to_utf8_size_avx2(s, z, pm);
+		if (z != p || (size_t)(z - s) >= 8)
+			return s; /* 0 was found or the engine has stopped before invalid utf32 character */
+	}
+}
+
+#endif /* LIBUTF16_AVX2 */
+
+/* convert a run of ascii characters, 4 utf32_char_t's at a time,
+  there must be more than 4 utf32_char_t's in the source buffer and more than 4 free utf8_char_t's in the destination,
+  returns pointer to the first non-converted utf32_char_t, at least one utf32_char_t and one free utf8_char_t are left */
+static const UTF32_CHAR_T *utf32_to_utf8_ascii(
+	const UTF32_CHAR_T *s, const UTF32_CHAR_T *const se,
+	utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	utf8_char_t *d = *b;
+	size_t n = (size_t)(se - s);
+	if (n > (size_t)(e - d))
+		n = (size_t)(e - d);
+	do {
+		const utf_word64_t w[2] = {utf_load64(s), utf_load64(s + 2)};
+		UTF32_CHAR_T c[4];
+		unsigned i = 0;
+		if ((w[0] | w[1]) & UTF32_SWAR_NOT_ASCII) {
+			/* convert ascii characters before the non-ascii one */
+			for (; UTF32_GET(s + i) < 0x80; i++)
+				d[i] = (utf8_char_t)UTF32_GET(s + i);
+			s += i;
+			d += i;
+			break;
+		}
+		memcpy(c, w, sizeof(c));
+		for (; i < 4; i++)
+			d[i] = (utf8_char_t)UTF32_GET((const UTF32_CHAR_T*)c + i);
+		s += 4;
+		d += 4;
+		n -= 4;
+	} while (n > 4);
+	*b = d;
+	return s;
+}
+
+/* convert utf32 characters, when the output buffer has a space for the worst-case expansion of them:
+  there must be at least 4 free utf8_char_t's in the destination for each utf32_char_t in the source buffer,
+  so the space in the output buffer need not be checked,
+  stops at the end of the input or before invalid utf32 character, so the checked loop reports it,
+  returns pointer beyond the last converted utf32_char_t, updates (*b) */
+static const UTF32_CHAR_T *utf32_to_utf8_wide(
+	const UTF32_CHAR_T *s, const UTF32_CHAR_T *const se,
+	utf8_char_t *LIBUTF16_RESTRICT *const b, const utf8_char_t *const e)
+{
+	utf8_char_t *LIBUTF16_RESTRICT d = *b;
+	while (s != se) {
+		unsigned c = UTF32_GET(s);
+		if (c >= 0x80) {
+			if (c >= 0x800) {
+				if (c > 0xFFFF) {
+					if (c > 0x10FFFF)
+						break; /* unicode code point must be <= 0x10FFFF */
+					c += 0x3C00000;
+					*d++ = (utf8_char_t)(c >> 18);
+					c = (c & 0x3FFFF) + 0x80000;
+				}
+				else if (0xD800 <= c && c <= 0xDFFF)
+					break; /* must not be a surrogate */
+				else
+					c += 0xE0000;
+				*d++ = (utf8_char_t)(c >> 12);
+				c = (c & 0xFFF) + 0x2000;
+			}
+			else
+				c += 0x3000;
+			*d++ = (utf8_char_t)(c >> 6);
+			c = (c & 0x3F) + 0x80;
+		}
+		else if ((size_t)(se - s) > 4 && UTF32_GET(s + 1) < 0x80) {
+			s = utf32_to_utf8_ascii(s, se, &d, e);
+			continue;
+		}
+		*d++ = (utf8_char_t)c;
+		s++;
+	}
+	*b = d;
+	return s;
+}
+
 /*
  utf32_to_utf8_z_
  utf32x_to_utf8_z_
@@ -54,6 +430,15 @@ size_t UTF_FORM_NAME(_z_)(
 	if (sz) {
 		utf8_char_t *LIBUTF16_RESTRICT d = *b;
 		const utf8_char_t *const e = d + sz;
+#ifdef UTF32_TO_UTF8_AVX512
+		if (libutf16_cpu_features() & UTF_CPU_AVX512)
+			s = utf32_to_utf8_z_avx512(s, &d, e);
+		else
+#endif
+#ifdef UTF32_TO_UTF8_AVX2
+		if (sz >= 64 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+			s = utf32_to_utf8_z_avx2(s, &d, e);
+#endif
 		do {
 			unsigned c = UTF32_GET(s++);
 			if (c >= 0x80) {
@@ -127,6 +512,10 @@ size_t UTF_FORM_NAME(_z_)(
 	  safely increment 'm' at least by 4 without integer overflow */
 	{
 		const UTF32_CHAR_T *const t = s - (m != 0); /* points beyond the last converted non-0 utf32_char_t */
+#ifdef UTF32_TO_UTF8_AVX2
+		if (libutf16_cpu_features() & UTF_CPU_AVX2)
+			s = utf32_to_utf8_z_size_avx2(s, &m);
+#endif
 		for (;;) {
 			unsigned c = UTF32_GET(s++);
 			if (c >= 0x80) {
@@ -174,6 +563,32 @@ size_t UTF_FORM_NAME(_)(
 		if (sz) {
 			utf8_char_t *LIBUTF16_RESTRICT d = *b;
 			const utf8_char_t *const e = d + sz;
+#ifdef UTF32_TO_UTF8_AVX512
+			if (n >= UTF32_AVX512_MIN && (libutf16_cpu_features() & UTF_CPU_AVX512)) {
+				s = utf32_to_utf8_avx512(s, se, &d, e);
+				if (se == s) {
+					sz = (size_t)(d - *b);
+					*w = s; /* (*w) == se */
+					*b = d;
+					return sz; /* ok, >0 and <= dst buffer size */
+				}
+			}
+			else
+#endif
+#ifdef UTF32_TO_UTF8_AVX2
+			if (libutf16_cpu_features() & UTF_CPU_AVX2)
+				s = utf32_to_utf8_avx2(s, se, &d, e);
+#endif
+			if ((size_t)(e - d)/4 >= (size_t)(se - s)) {
+				/* output buffer is large enough for any utf32 string of remaining length */
+				s = utf32_to_utf8_wide(s, se, &d, e);
+				if (se == s) {
+					sz = (size_t)(d - *b);
+					*w = s; /* (*w) == se */
+					*b = d;
+					return sz; /* ok, >0 and <= dst buffer size */
+				}
+			}
 			do {
 				unsigned c = UTF32_GET(s++);
 				if (c >= 0x80) {
@@ -220,6 +635,11 @@ size_t UTF_FORM_NAME(_)(
 					d[-2] = (utf8_char_t)(c >> 6);
 					c = (c & 0x3F) + 0x80;
 				}
+				else if ((size_t)(se - s) > 4 && (size_t)(e - d) > 5 && UTF32_GET(s) < 0x80) {
+					*d++ = (utf8_char_t)c;
+					s = utf32_to_utf8_ascii(s, se, &d, e);
+					continue; /* (d != e) */
+				}
 				else
 					d++;
 				d[-1] = (utf8_char_t)c;
@@ -245,7 +665,11 @@ size_t UTF_FORM_NAME(_)(
 		  safely increment 'm' at least by 4 without integer overflow */
 		{
 			const UTF32_CHAR_T *const t = s - (m != 0); /* points beyond the last converted utf32_char_t, t < se */
-			do {
+#ifdef UTF32_TO_UTF8_AVX2
+			if ((size_t)(se - s) >= 8 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+				s = utf32_to_utf8_size_avx2(s, se, &m);
+#endif
+			while (s != se) {
 				unsigned c = UTF32_GET(s++);
 				if (c >= 0x80) {
 					if (c >= 0x800) {
@@ -264,7 +688,7 @@ size_t UTF_FORM_NAME(_)(
 					}
 					m++;
 				}
-			} while (s != se);
+			}
 			sz += m + (size_t)(s - t);
 			*w = t; /* points after the last successfully converted utf32_char_t, (*w) < se */
 			return sz; /* ok, >0, but > dst buffer size */
@@ -273,6 +697,190 @@ size_t UTF_FORM_NAME(_)(
 	return 0; /* n is zero */
 }
 
+/*
+ utf32_to_utf8_alloc
+ utf32x_to_utf8_alloc
+ utf32u_to_utf8_alloc
+ utf32ux_to_utf8_alloc
+*/
+size_t UTF_FORM_NAME(_alloc)(
+	const UTF32_CHAR_T **const LIBUTF16_RESTRICT w,
+	utf8_char_t **const LIBUTF16_RESTRICT b,
+	const size_t n, const int shrink)
+{
+	utf8_char_t *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	buf = (utf8_char_t*)utf_alloc_buf(UTF32_TO_UTF8_MAX(n), sizeof(*buf));
+	if (!buf)
+		return (size_t)-1; /* not enough memory */
+	d = buf;
+	/* the output buffer is large enough, so the conversion may only fail on invalid input */
+	m = UTF_FORM_NAME(_)(w, &d, UTF32_TO_UTF8_MAX(n), n, /*determ_size:*/0);
+	if (!m) {
+		free(buf);
+		return 0; /* invalid utf32 string */
+	}
+	if (shrink && m < UTF32_TO_UTF8_MAX(n))
+		buf = (utf8_char_t*)utf_shrink_buf(buf, m*sizeof(*buf));
+	*b = buf;
+	return m;
+}
+
+/*
+ utf32_to_utf8_arena
+ utf32x_to_utf8_arena
+ utf32u_to_utf8_arena
+ utf32ux_to_utf8_arena
+*/
+size_t UTF_FORM_NAME(_arena)(
+	const UTF32_CHAR_T **const LIBUTF16_RESTRICT w,
+	utf8_char_t **const LIBUTF16_RESTRICT b,
+	const size_t n, utf_arena_t *const LIBUTF16_RESTRICT a)
+{
+	utf8_char_t *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	if (n <= a->chunk_size/sizeof(*buf)/UTF32_TO_UTF8_MAX(1)) {
+		/* worst-case size fits in a chunk: allocate it and then return unused tail to the arena */
+		buf = (utf8_char_t*)utf_arena_alloc(a, UTF32_TO_UTF8_MAX(n)*sizeof(*buf));
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		/* the output buffer is large enough, so the conversion may only fail on invalid input */
+		m = UTF_FORM_NAME(_)(w, &d, UTF32_TO_UTF8_MAX(n), n, /*determ_size:*/0);
+		utf_arena_trim(a, m ? d : buf);
+		if (!m)
+			return 0; /* invalid utf32 string */
+	}
+	else {
+		/* long string: determine exact size of the output buffer, then convert without validating again */
+		utf_valid_token_t t;
+		m = UTF_FORM_NAME(_size_token)(w, n, &t);
+		if (!m)
+			return 0; /* invalid utf32 string */
+		buf = m <= (size_t)-1/sizeof(*buf) ? (utf8_char_t*)utf_arena_alloc(a, m*sizeof(*buf)) : NULL;
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		(void)UTF_FORM_NAME(_from_token)(&t, &d, m);
+		*w = (const UTF32_CHAR_T*)*w + n;
+	}
+	*b = buf;
+	return m;
+}
+
+/*
+ utf32_to_utf8_grow
+ utf32x_to_utf8_grow
+ utf32u_to_utf8_grow
+ utf32ux_to_utf8_grow
+*/
+size_t UTF_FORM_NAME(_grow)(
+	const UTF32_CHAR_T **const LIBUTF16_RESTRICT w,
+	utf_grow_buf_t *const LIBUTF16_RESTRICT g,
+	size_t n)
+{
+	const size_t len = g->len;
+	while (n) {
+		if (g->len != g->cap) {
+			const UTF32_CHAR_T *const s = *w;
+			utf8_char_t *const o = (utf8_char_t*)g->buf + g->len;
+			utf8_char_t *d = o;
+			const size_t sz = g->cap - g->len;
+			const size_t m = UTF_FORM_NAME(_)(w, &d, sz, n, /*determ_size:*/0);
+			g->len += (size_t)(d - o);
+			if (!m)
+				return 0; /* invalid/incomplete utf32 character */
+			if (m <= sz)
+				return g->len - len; /* ok, all 'n' utf32_char_t's were converted */
+			/* output buffer is full, continue from the last converted utf32_char_t */
+			n -= (size_t)(*w - s);
+		}
+		/* each of remaining utf32_char_t's produces at least one utf8_char_t */
+		if (!utf_grow_buf(g, n, sizeof(utf8_char_t)))
+			return (size_t)-1; /* not enough memory */
+	}
+	return 0; /* n is zero */
+}
+
+/*
+ utf32_to_utf8_size_token
+ utf32x_to_utf8_size_token
+ utf32u_to_utf8_size_token
+ utf32ux_to_utf8_size_token
+*/
+size_t UTF_FORM_NAME(_size_token)(
+	const UTF32_CHAR_T **const LIBUTF16_RESTRICT w,
+	const size_t n,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const size_t sz = UTF_FORM_NAME(_)(w, /*b:*/NULL, /*sz:*/0, n, /*determ_size:*/1);
+	t->src = sz ? *w : NULL;
+	t->n = sz ? n : 0;
+	t->size = sz;
+	t->kind = sz ? UTF_TOKEN_KIND : 0;
+	return sz;
+}
+
+/*
+ utf32_to_utf8_z_size_token
+ utf32x_to_utf8_z_size_token
+ utf32u_to_utf8_z_size_token
+ utf32ux_to_utf8_z_size_token
+*/
+size_t UTF_FORM_NAME(_z_size_token)(
+	const UTF32_CHAR_T **const LIBUTF16_RESTRICT w,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const UTF32_CHAR_T *const s = *w;
+	const size_t sz = UTF_FORM_NAME(_z_)(w, /*b:*/NULL, /*sz:*/0, /*determ_size:*/2);
+	if (!sz) {
+		t->src = NULL;
+		t->n = 0;
+		t->size = 0;
+		t->kind = 0;
+		return 0; /* invalid utf32 string */
+	}
+	t->src = s;
+	t->n = (size_t)(*w - s);
+	t->size = sz;
+	t->kind = UTF_TOKEN_KIND;
+	*w = s; /* (*w) was moved beyond the 0-terminator */
+	return sz;
+}
+
+/*
+ utf32_to_utf8_from_token
+ utf32x_to_utf8_from_token
+ utf32u_to_utf8_from_token
+ utf32ux_to_utf8_from_token
+*/
+size_t UTF_FORM_NAME(_from_token)(
+	const utf_valid_token_t *const LIBUTF16_RESTRICT t,
+	utf8_char_t **const LIBUTF16_RESTRICT b,
+	const size_t sz)
+{
+	if (t->kind != UTF_TOKEN_KIND)
+		return 0; /* the token is empty or was filled by another conversion */
+	if (t->size > sz)
+		return t->size; /* output buffer is too small */
+#ifdef UTF32_TO_UTF8_AVX2
+	if (libutf16_cpu_features() & UTF_CPU_AVX2) {
+		/* the engine validates the string nearly for free and is faster than the unchecked scalar code */
+		const UTF32_CHAR_T *w = (const UTF32_CHAR_T*)t->src;
+		return UTF_FORM_NAME(_)(&w, b, t->size, t->n, /*determ_size:*/0);
+	}
+#endif
+	UTF_FORM_NAME(_unsafe)((const UTF32_CHAR_T*)t->src, *b, t->n);
+	*b += t->size;
+	return t->size;
+}
+
 /*
  utf32_to_utf8_z_unsafe
  utf32x_to_utf8_z_unsafe
@@ -357,6 +965,11 @@ void UTF_FORM_NAME(_unsafe)(
 			b[-2] = (utf8_char_t)(c >> 6);
 			c = (c & 0x3F) + 0x80;
 		}
+		else if ((size_t)(we - w) > 4 && UTF32_GET(w) < 0x80) {
+			*b++ = (utf8_char_t)c;
+			w = utf32_to_utf8_ascii(w, we, &b, b + (we - w));
+			continue; /* (w != we) */
+		}
 		else
 			b++;
 		b[-1] = (utf8_char_t)c;
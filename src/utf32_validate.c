@@ -0,0 +1,139 @@
+/**********************************************************************************
+* UTF-32 strings validation
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf32_validate.c */
+
+#include <stddef.h> /* for size_t */
+
+#ifndef _MSC_VER
+#include <stdint.h> /* for uint32_t */
+#endif
+
+#ifdef _MSC_VER
+#include <stdlib.h> /* for _byteswap_ushort()/_byteswap_ulong() */
+#endif
+
+#include <memory.h> /* for memcpy() */
+
+#include "libutf16/utf32_validate.h"
+#include "libutf16/utf16_swap.h"
+
+#include "utf16_internal.h"
+#include "utf16_simd.h"
+
+#ifdef _MSC_VER
+#pragma warning(disable:5045) /* Compiler will insert Spectre mitigation for memory load if /Qspectre switch specified */
+#endif
+
+#ifdef UTF_GET_UNALIGNED
+#define UTF32_CHAR_T utf32_char_unaligned_t
+#else
+#define UTF32_CHAR_T utf32_char_t
+#endif
+
+#define UTF_FORM_NAME2(fu, fx, suffix)  utf32##fu##fx##_validate##suffix
+#define UTF_FORM_NAME1(fu, fx, suffix)  UTF_FORM_NAME2(fu, fx, suffix)
+#define UTF_FORM_NAME(suffix)           UTF_FORM_NAME1(UTF_GET_U, UTF32_X, suffix)
+
+#ifdef LIBUTF16_AVX2
+
+/* load 8 utf32_char_t's */
+UTF_TARGET_AVX2
+static inline __m256i utf32_validate_avx2_load(const UTF32_CHAR_T *const s)
+{
+#ifdef SWAP_UTF32
+	return _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)s), _mm256_setr_epi8(
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+#else
+	return _mm256_loadu_si256((const __m256i*)s);
+#endif
+}
+
+/* AVX2 engine: validate blocks of 8 utf32_char_t's, while they remain in the input,
+  stops before a block containing invalid utf32 character, so the scalar code reports it at exact position,
+  returns pointer beyond the last validated utf32_char_t */
+UTF_TARGET_AVX2
+static const UTF32_CHAR_T *utf32_validate_avx2(const UTF32_CHAR_T *s, const UTF32_CHAR_T *const se)
+{
+	while ((size_t)(se - s) >= 8 && utf32_avx2_valid(utf32_validate_avx2_load(s)))
+		s += 8;
+	return s;
+}
+
+/* size of a window, in which the terminating 0 is searched before validating its part by the engine */
+#define UTF32_Z_WINDOW 1024
+
+/* AVX2 engine for 0-terminated utf32 string: validate its part before the terminating 0 */
+UTF_TARGET_AVX2
+static const UTF32_CHAR_T *utf32_validate_z_avx2(const UTF32_CHAR_T *s)
+{
+	const UTF32_CHAR_T *z = s;
+	for (;;) {
+		const UTF32_CHAR_T *const p = z + UTF32_Z_WINDOW;
+		z += utf_avx2_find0(z, UTF32_Z_WINDOW, sizeof(*z));
+		s = utf32_validate_avx2(s, z);
+		if (z != p || (size_t)(z - s) >= 8)
+			return s; /* 0 was found or the engine has stopped before invalid utf32 character */
+	}
+}
+
+#endif /* LIBUTF16_AVX2 */
+
+/*
+ utf32_validate_z
+ utf32x_validate_z
+ utf32u_validate_z
+ utf32ux_validate_z
+*/
+int UTF_FORM_NAME(_z)(
+	const UTF32_CHAR_T **const q/*in,out,!=NULL*/)
+{
+	const UTF32_CHAR_T *s = *q;
+#ifdef LIBUTF16_AVX2
+	if (libutf16_cpu_features() & UTF_CPU_AVX2)
+		s = utf32_validate_z_avx2(s);
+#endif
+	for (;; s++) {
+		const utf32_char_t c = UTF32_GET(s);
+		if (c > 0x10FFFF || 0xD800 == (c & 0xFFFFF800))
+			break; /* unicode code point must be <= 0x10FFFF and must not be a surrogate */
+		if (!c) {
+			*q = s + 1; /* points beyond the 0-terminator */
+			return 1;
+		}
+	}
+	*q = s; /* (*q) points to invalid utf32 character */
+	return 0;
+}
+
+/*
+ utf32_validate
+ utf32x_validate
+ utf32u_validate
+ utf32ux_validate
+*/
+int UTF_FORM_NAME()(
+	const UTF32_CHAR_T **const q/*in,out,!=NULL if n>0*/,
+	const size_t n/*0?*/)
+{
+	if (n) {
+		const UTF32_CHAR_T *s = *q;
+		const UTF32_CHAR_T *const se = s + n;
+#ifdef LIBUTF16_AVX2
+		if (n >= 8 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+			s = utf32_validate_avx2(s, se);
+#endif
+		for (; s != se; s++) {
+			const utf32_char_t c = UTF32_GET(s);
+			if (c > 0x10FFFF || 0xD800 == (c & 0xFFFFF800)) {
+				*q = s; /* (*q) < se */
+				return 0; /* unicode code point must be <= 0x10FFFF and must not be a surrogate */
+			}
+		}
+		*q = se;
+	}
+	return 1;
+}
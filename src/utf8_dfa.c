@@ -0,0 +1,67 @@
+/**********************************************************************************
+* Table-driven DFA decoder of utf8 characters
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf8_dfa.c */
+
+#include <memory.h> /* for memcpy() */
+
+#include "utf16_swar.h"
+#include "utf8_dfa.h"
+
+/* the automaton of Bjoern Hoehrmann's "Flexible and Economical UTF-8 Decoder",
+  http://bjoern.hoehrmann.de/utf-8/decoder/dfa/, with transitions packed into one 64-bit row per utf8_char_t:
+  the next state is obtained by shifting the row by the current state, so loading of the row does not depend
+  on the state and only the shift is on the critical path of decoding */
+
+/* mask of code point bits of utf8_char_t, next states: from accepting, rejecting, CONT1, CONT2, E0, ED, F0, F1, F4 */
+#define UTF8_DFA_ROW(mask, a, r, c1, c2, e0, ed, f0, f1, f4) ( \
+	(utf_word64_t)(mask) << 56 | \
+	(utf_word64_t)(a)  << UTF8_DFA_ACCEPT | (utf_word64_t)(r)  << UTF8_DFA_REJECT | \
+	(utf_word64_t)(c1) << UTF8_DFA_CONT1  | (utf_word64_t)(c2) << UTF8_DFA_CONT2  | \
+	(utf_word64_t)(e0) << UTF8_DFA_E0     | (utf_word64_t)(ed) << UTF8_DFA_ED     | \
+	(utf_word64_t)(f0) << UTF8_DFA_F0     | (utf_word64_t)(f1) << UTF8_DFA_F1     | \
+	(utf_word64_t)(f4) << UTF8_DFA_F4)
+
+#define A_  UTF8_DFA_ACCEPT
+#define R_  UTF8_DFA_REJECT
+#define C1_ UTF8_DFA_CONT1
+#define C2_ UTF8_DFA_CONT2
+
+/* 00..7F */
+#define U0 UTF8_DFA_ROW(0x7F, A_, R_, R_, R_, R_, R_, R_, R_, R_)
+/* 80..8F */
+#define U8 UTF8_DFA_ROW(0x3F, R_, R_, A_, C1_, R_, C1_, R_, C2_, C2_)
+/* 90..9F */
+#define U9 UTF8_DFA_ROW(0x3F, R_, R_, A_, C1_, R_, C1_, C2_, C2_, R_)
+/* A0..BF */
+#define UA UTF8_DFA_ROW(0x3F, R_, R_, A_, C1_, C1_, R_, C2_, C2_, R_)
+/* C2..DF */
+#define UC UTF8_DFA_ROW(0x1F, C1_, R_, R_, R_, R_, R_, R_, R_, R_)
+/* E0 */
+#define E0 UTF8_DFA_ROW(0x0F, UTF8_DFA_E0, R_, R_, R_, R_, R_, R_, R_, R_)
+/* E1..EC, EE, EF */
+#define UE UTF8_DFA_ROW(0x0F, C2_, R_, R_, R_, R_, R_, R_, R_, R_)
+/* ED */
+#define ED UTF8_DFA_ROW(0x0F, UTF8_DFA_ED, R_, R_, R_, R_, R_, R_, R_, R_)
+/* F0 */
+#define F0 UTF8_DFA_ROW(0x07, UTF8_DFA_F0, R_, R_, R_, R_, R_, R_, R_, R_)
+/* F1..F3 */
+#define F1 UTF8_DFA_ROW(0x07, UTF8_DFA_F1, R_, R_, R_, R_, R_, R_, R_, R_)
+/* F4 */
+#define F4 UTF8_DFA_ROW(0x07, UTF8_DFA_F4, R_, R_, R_, R_, R_, R_, R_, R_)
+/* C0, C1, F5..FF */
+#define XX UTF8_DFA_ROW(0x00, R_, R_, R_, R_, R_, R_, R_, R_, R_)
+
+const utf_word64_t libutf16_utf8_dfa[256] = {
+	U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0, /* 00..1F */
+	U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0, /* 20..3F */
+	U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0, /* 40..5F */
+	U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0,U0, /* 60..7F */
+	U8,U8,U8,U8,U8,U8,U8,U8,U8,U8,U8,U8,U8,U8,U8,U8,U9,U9,U9,U9,U9,U9,U9,U9,U9,U9,U9,U9,U9,U9,U9,U9, /* 80..9F */
+	UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA,UA, /* A0..BF */
+	XX,XX,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC,UC, /* C0..DF */
+	E0,UE,UE,UE,UE,UE,UE,UE,UE,UE,UE,UE,UE,ED,UE,UE,F0,F1,F1,F1,F4,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX,XX  /* E0..FF */
+};
@@ -0,0 +1,59 @@
+#ifndef UTF8_DFA_H_INCLUDED
+#define UTF8_DFA_H_INCLUDED
+
+/**********************************************************************************
+* Table-driven DFA decoder of utf8 characters
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf8_dfa.h */
+
+/* alternative scalar decoder of utf8 for bulk utf8 -> utf16/utf32 conversions, for targets without SIMD engines:
+  each utf8_char_t selects a row of the transition table, which gives the next state of the automaton for
+  the current one, while the code point is accumulated without branching on the structure of utf8 characters.
+  Converters store decoded characters unconditionally and advance destination pointer only for complete ones,
+  so the throughput does not depend on the mix of scripts in the text - there are no mispredicted branches,
+  but on a text of one script the branchy decoder, which handles whole characters, is usually faster.
+  To use the automaton in the scalar code of utf8 -> utf16/utf32 conversions, define LIBUTF16_UTF8_DFA. */
+
+/* note: #include "utf16_swar.h" for utf_word64_t */
+
+/* rows of the transition table, by utf8_char_t: 6-bit fields, by current states, with next states,
+  the highest byte - mask of code point bits of the utf8_char_t */
+extern const utf_word64_t libutf16_utf8_dfa[256];
+
+/* states of the automaton - shift counts of the fields in the rows of the transition table */
+#define UTF8_DFA_ACCEPT 0  /* at the beginning of utf8 character */
+#define UTF8_DFA_REJECT 6  /* invalid utf8 character, the automaton stays in this state */
+#define UTF8_DFA_CONT1  12 /* one continuation byte 80..BF is expected */
+#define UTF8_DFA_CONT2  18 /* two continuation bytes 80..BF are expected */
+#define UTF8_DFA_E0     24 /* after E0: A0..BF is expected, then a continuation byte */
+#define UTF8_DFA_ED     30 /* after ED: 80..9F is expected, then a continuation byte */
+#define UTF8_DFA_F0     36 /* after F0: 90..BF is expected, then two continuation bytes */
+#define UTF8_DFA_F1     42 /* after F1..F3: 80..BF is expected, then two continuation bytes */
+#define UTF8_DFA_F4     48 /* after F4: 80..8F is expected, then two continuation bytes */
+
+#ifdef LIBUTF16_UTF8_DFA
+
+/* state of the automaton, st - the value updated by utf8_dfa_step() */
+#define UTF8_DFA_STATE(st) ((unsigned)(st) & 63)
+
+/* feed utf8_char_t x to the automaton in state (*st), accumulate code point in (*c),
+  the code point is complete if the new state is UTF8_DFA_ACCEPT,
+  returns all-ones mask if the utf8_char_t has started a new utf8 character, else 0.
+  Note: masks are used instead of conditions: compilers tend to make branches of them, which are mispredicted
+  on a text of mixed scripts; the state is not masked by 63 - shift instructions of most cpus do that */
+static inline unsigned utf8_dfa_step(utf_word64_t *const st, unsigned *const c, const unsigned x)
+{
+	const utf_word64_t r = libutf16_utf8_dfa[x];
+	const unsigned m = 0u - (unsigned)(UTF8_DFA_ACCEPT == UTF8_DFA_STATE(*st));
+	const unsigned k = 0u - (unsigned)(0x80 == (x & 0xC0)); /* continuation byte */
+	*c = ((*c << 6) & k) | (x & (unsigned)(r >> 56));
+	*st = r >> UTF8_DFA_STATE(*st);
+	return m;
+}
+
+#endif /* LIBUTF16_UTF8_DFA */
+
+#endif /* UTF8_DFA_H_INCLUDED */
@@ -16,12 +16,15 @@
 #include <stdlib.h> /* for _byteswap_ushort()/_byteswap_ulong() */
 #endif
 
-#include <memory.h> /* for memcpy() */
+#include <memory.h> /* for memcpy()/memchr() */
 
 #include "libutf16/utf8_to_utf16.h"
 #include "libutf16/utf16_swap.h"
 
 #include "utf16_internal.h"
+#include "utf16_simd.h"
+#include "utf16_swar.h"
+#include "utf8_dfa.h"
 
 #ifdef _MSC_VER
 #pragma warning(disable:5045) /* Compiler will insert Spectre mitigation for memory load if /Qspectre switch specified */
@@ -37,6 +40,570 @@
 #define UTF_FORM_NAME1(tu, tx, suffix)  UTF_FORM_NAME2(tu, tx, suffix)
 #define UTF_FORM_NAME(suffix)           UTF_FORM_NAME1(UTF_PUT_U, UTF16_X, suffix)
 
+/* kind of tokens of validated strings, filled and accepted by this form of conversion */
+#define UTF_TOKEN_KIND UTF_TOKEN_UTF8_TO_UTF16
+
+#ifdef LIBUTF16_AVX512
+#define UTF8_TO_UTF16_AVX512
+
+/* store n (<= 32) 16-bit lanes of v as utf16_char_t's */
+UTF_TARGET_AVX512
+static inline UTF16_CHAR_T *utf8_to_utf16_avx512_store(UTF16_CHAR_T *const d, __m512i v, const unsigned n)
+{
+#ifdef SWAP_UTF16
+	v = _mm512_shldi_epi16(v, v, 8);
+#endif
+	_mm512_mask_storeu_epi16(d, _bzhi_u32(0xFFFFFFFFu, n), v);
+	return d + n;
+}
+
+/* decode 16 utf8 characters to 32-bit lanes, each lane of x contains 4 bytes starting from the first byte
+  of a utf8 character, k2, k3, k4 - masks of lanes with 2-4, 3-4 and 4-byte characters.
+  Returns lanes with utf16_char_t in the low half and, for 4-byte characters, low surrogate in the high half */
+UTF_TARGET_AVX512
+static inline __m512i utf8_to_utf16_avx512_decode(const __m512i x,
+	const __mmask16 k2, const __mmask16 k3, const __mmask16 k4)
+{
+	const __m512i m = _mm512_set1_epi32(0x3F);
+	const __m512i a = _mm512_and_si512(x, _mm512_set1_epi32(0xFF));
+	const __m512i t1 = _mm512_and_si512(_mm512_srli_epi32(x, 8), m);
+	/* 110aaaaa 10bbbbbb -> 00000aaaaabbbbbb */
+	__m512i v = _mm512_mask_or_epi32(a, k2,
+		_mm512_slli_epi32(_mm512_and_si512(a, _mm512_set1_epi32(0x1F)), 6), t1);
+	if (k3) {
+		const __m512i t2 = _mm512_and_si512(_mm512_srli_epi32(x, 16), m);
+		/* 1110aaaa 10bbbbbb 10cccccc -> aaaabbbbbbcccccc */
+		v = _mm512_mask_or_epi32(v, k3,
+			_mm512_slli_epi32(_mm512_and_si512(a, _mm512_set1_epi32(0xF)), 12),
+			_mm512_or_si512(_mm512_slli_epi32(t1, 6), t2));
+		if (k4) {
+			/* 11110aaa 10bbbbbb 10cccccc 10dddddd -> 000aaabbbbbbccccccdddddd */
+			const __m512i c = _mm512_or_si512(
+				_mm512_or_si512(_mm512_slli_epi32(_mm512_and_si512(a, _mm512_set1_epi32(7)), 18), _mm512_slli_epi32(t1, 12)),
+				_mm512_or_si512(_mm512_slli_epi32(t2, 6), _mm512_and_si512(_mm512_srli_epi32(x, 24), m)));
+			/* -> (0xD800 + ((c - 0x10000) >> 10)) | (0xDC00 + (c & 0x3FF)) << 16 */
+			v = _mm512_mask_or_epi32(v, k4,
+				_mm512_add_epi32(_mm512_srli_epi32(c, 10), _mm512_set1_epi32(0xD7C0)),
+				_mm512_slli_epi32(_mm512_or_si512(_mm512_and_si512(c, _mm512_set1_epi32(0x3FF)), _mm512_set1_epi32(0xDC00)), 16));
+		}
+	}
+	return v;
+}
+
+/* AVX-512 engine: validate and convert a block of l (1..64) utf8_char_t's, bytes of v beyond the l-th are zero,
+  l < 64 - the input ends with the block,
+  fill - the input ends with the block and the output buffer may be filled completely,
+  else there must remain a space for at least one utf16_char_t after the converted ones.
+  Uses masked stores, so writes nothing beyond the converted utf16_char_t's.
+  Returns number of converted utf8_char_t's, 0 if the block starts with invalid or incomplete
+  utf8 character or there is not enough space in the output buffer, updates (*pd) */
+UTF_TARGET_AVX512
+static UTF_FORCE_INLINE unsigned utf8_to_utf16_avx512_block(const __m512i v, const unsigned l,
+	UTF16_CHAR_T **const pd, const UTF16_CHAR_T *const e, const int fill)
+{
+	const size_t room = (size_t)(e - (const UTF16_CHAR_T*)*pd);
+	const __mmask64 hi = _mm512_movepi8_mask(v);
+	if (!hi) {
+		if (l >= room + !!fill)
+			return 0; /* not enough space in the output buffer */
+		*pd = utf8_to_utf16_avx512_store(*pd, _mm512_cvtepu8_epi16(_mm512_castsi512_si256(v)), l < 32 ? l : 32);
+		if (l > 32)
+			*pd = utf8_to_utf16_avx512_store(*pd, _mm512_cvtepu8_epi16(_mm512_extracti64x4_epi64(v, 1)), l - 32);
+		return l;
+	}
+	{
+		/* for each byte: that byte and the following three ones */
+		const __m512i idx = _mm512_setr_epi32(
+			0x03020100, 0x04030201, 0x05040302, 0x06050403, 0x07060504, 0x08070605, 0x09080706, 0x0A090807,
+			0x0B0A0908, 0x0C0B0A09, 0x0D0C0B0A, 0x0E0D0C0B, 0x0F0E0D0C, 0x100F0E0D, 0x11100F0E, 0x1211100F);
+		/* the block shifted by one byte */
+		const __m512i v1 = _mm512_permutexvar_epi8(_mm512_setr_epi32(
+			0x04030201, 0x08070605, 0x0C0B0A09, 0x100F0E0D, 0x14131211, 0x18171615, 0x1C1B1A19, 0x201F1E1D,
+			0x24232221, 0x28272625, 0x2C2B2A29, 0x302F2E2D, 0x34333231, 0x38373635, 0x3C3B3A39, 0x003F3E3D), v);
+		__mmask64 st, ge_e0, ge_f0, r;
+		const unsigned n = utf8_avx512_check(v, v1, l, hi, &st, &ge_e0, &ge_f0);
+		if (!n)
+			return 0; /* invalid or incomplete utf8 character */
+		r = _bzhi_u64(~0ull, n); /* mask of bytes to process */
+		st &= r;
+		ge_f0 &= r;
+		{
+			const size_t units = utf_popcnt64(st) + utf_popcnt64(ge_f0);
+			if (units >= room + (fill && n == l))
+				return 0; /* not enough space in the output buffer */
+		}
+		{
+			const __mmask64 k2 = st & hi, k3 = ge_e0 & r;
+			UTF16_CHAR_T *d = *pd;
+			unsigned g;
+			for (g = 0; g < 64; g += 16) {
+				const unsigned k = (unsigned)(st >> g) & 0xFFFF;
+				if (k) {
+					const unsigned k4 = (unsigned)(ge_f0 >> g) & 0xFFFF;
+					/* for each character, take its utf16_char_t and, for 4-byte one, also its low surrogate */
+					const unsigned w = _pdep_u32(k, 0x55555555u) | _pdep_u32(k4, 0xAAAAAAAAu);
+					d = utf8_to_utf16_avx512_store(d, _mm512_maskz_compress_epi16(w,
+						utf8_to_utf16_avx512_decode(
+							_mm512_permutexvar_epi8(_mm512_add_epi8(idx, _mm512_set1_epi8((char)g)), v),
+							(__mmask16)(k2 >> g), (__mmask16)(k3 >> g), (__mmask16)k4)), utf_popcnt32(w));
+				}
+			}
+			*pd = d;
+		}
+		return n;
+	}
+}
+
+/* AVX-512 engine: validate and convert blocks of 64 utf8_char_t's, the last block is read by a masked load:
+ - each block is converted up to the last complete utf8 character in it,
+ - stops before a block containing invalid utf8 character, so the scalar code reports it at exact position,
+ - stops if there is not enough space in the output buffer for the next block,
+ - if not all utf8_char_t's are converted, leaves a space for at least one utf16_char_t in the output buffer.
+ returns pointer beyond the last converted utf8_char_t, updates (*b) */
+UTF_TARGET_AVX512
+static const utf8_char_t *utf8_to_utf16_avx512(
+	const utf8_char_t *s, const utf8_char_t *const se,
+	UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	UTF16_CHAR_T *d = *b;
+	do {
+		const size_t k = (size_t)(se - s);
+		unsigned l = 64, n;
+		__m512i v;
+		if (k > 64) {
+			v = _mm512_loadu_si512(s);
+			if (!_mm512_movepi8_mask(v) && (size_t)(e - (const UTF16_CHAR_T*)d) > 64) {
+				/* fast path for 64 one-byte utf8 characters */
+				d = utf8_to_utf16_avx512_store(d, _mm512_cvtepu8_epi16(_mm512_castsi512_si256(v)), 32);
+				d = utf8_to_utf16_avx512_store(d, _mm512_cvtepu8_epi16(_mm512_extracti64x4_epi64(v, 1)), 32);
+				s += 64;
+				continue;
+			}
+		}
+		else {
+			l = (unsigned)k;
+			v = _mm512_maskz_loadu_epi8(_bzhi_u64(~0ull, l), s);
+		}
+		n = utf8_to_utf16_avx512_block(v, l, &d, e, k <= 64);
+		if (!n)
+			break;
+		s += n;
+	} while (s != se);
+	*b = d;
+	return s;
+}
+
+/* AVX-512 engine for 0-terminated utf8 string: convert its part before the terminating 0,
+  never reading memory beyond the page containing the terminating 0,
+  leaves a space for at least one utf16_char_t in the output buffer */
+UTF_TARGET_AVX512
+static const utf8_char_t *utf8_to_utf16_z_avx512(
+	const utf8_char_t *s, UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	UTF16_CHAR_T *d = *b;
+	for (;;) {
+		__m512i v = utf_avx512_load_z(s, sizeof(*s));
+		const __mmask64 z = _mm512_testn_epi8_mask(v, v);
+		unsigned l = 64, n;
+		if (z) {
+			l = utf_bsf64(z);
+			if (!l)
+				break; /* the terminating 0 */
+			v = _mm512_maskz_mov_epi8(_bzhi_u64(~0ull, l), v);
+		}
+		n = utf8_to_utf16_avx512_block(v, l, &d, e, /*fill:*/0);
+		s += n;
+		if (!n || l != 64)
+			break; /* invalid utf8 character, not enough space in the output buffer or the terminating 0 is reached */
+	}
+	*b = d;
+	return s;
+}
+
+/* minimal length of utf8 string for the AVX-512 engine, shorter strings are faster converted by the scalar code */
+#define UTF8_AVX512_MIN 16
+
+#endif /* LIBUTF16_AVX512 */
+
+#ifdef LIBUTF16_AVX2
+#define UTF8_TO_UTF16_AVX2
+
+/* decode 16 utf8_char_t's to 16 utf16_char_t's, assuming each utf8_char_t starts a utf8 character:
+  a - first bytes of characters, b - second bytes, c - third bytes (zero-extended to 16 bits),
+  lv - 0: there are only 1- and 2-byte characters, 1: there are 3-byte ones, 2: there are 4-byte ones,
+  ls - mask of lanes following 4-byte characters, where low surrogates are stored */
+UTF_TARGET_AVX2
+static inline __m256i utf8_to_utf16_avx2_decode(
+	const __m256i a, const __m256i b, const __m256i c,
+	const unsigned lv, const unsigned ls)
+{
+	const __m256i t1 = _mm256_and_si256(b, _mm256_set1_epi16(0x3F));
+	const __m256i t2 = _mm256_and_si256(c, _mm256_set1_epi16(0x3F));
+	/* 110aaaaa 10bbbbbb -> 00000aaaaabbbbbb */
+	__m256i v = _mm256_blendv_epi8(a,
+		_mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(a, _mm256_set1_epi16(0x1F)), 6), t1),
+		_mm256_cmpgt_epi16(a, _mm256_set1_epi16(0xBF)));
+	if (lv) {
+		/* 1110aaaa 10bbbbbb 10cccccc -> aaaabbbbbbcccccc */
+		v = _mm256_blendv_epi8(v,
+			_mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(a, 12), _mm256_slli_epi16(t1, 6)), t2),
+			_mm256_cmpgt_epi16(a, _mm256_set1_epi16(0xDF)));
+		if (lv > 1) {
+			const __m256i bits = _mm256_setr_epi16(
+				0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80,
+				0x100, 0x200, 0x400, 0x800, 0x1000, 0x2000, 0x4000, (short)0x8000);
+			/* 11110aaa 10bbbbbb 10cccccc -> 0xD800 + (aaabbbbbbcccc >> 4) - 0x40 */
+			v = _mm256_blendv_epi8(v,
+				_mm256_add_epi16(
+					_mm256_add_epi16(_mm256_slli_epi16(_mm256_and_si256(a, _mm256_set1_epi16(7)), 8), _mm256_slli_epi16(t1, 2)),
+					_mm256_add_epi16(_mm256_srli_epi16(t2, 4), _mm256_set1_epi16((short)0xD7C0))),
+				_mm256_cmpgt_epi16(a, _mm256_set1_epi16(0xEF)));
+			/* 10bbbbbb 10cccccc 10dddddd -> 110111ccccdddddd */
+			v = _mm256_blendv_epi8(v,
+				_mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(t1, _mm256_set1_epi16(0xF)), 6), t2),
+					_mm256_set1_epi16((short)0xDC00)),
+				_mm256_cmpeq_epi16(_mm256_and_si256(_mm256_set1_epi16((short)ls), bits), bits));
+		}
+	}
+	return v;
+}
+
+/* store 16-bit lanes of v selected by 16-bit mask k */
+UTF_TARGET_AVX2
+static inline UTF16_CHAR_T *utf8_to_utf16_avx2_pack(
+	UTF16_CHAR_T *d, const __m256i v, const unsigned k)
+{
+	__m256i p = _mm256_inserti128_si256(_mm256_castsi128_si256(
+		_mm_loadu_si128((const __m128i*)libutf16_pack16_shuf[k & 0xFF])),
+		_mm_loadu_si128((const __m128i*)libutf16_pack16_shuf[k >> 8]), 1);
+#ifdef SWAP_UTF16
+	/* swap bytes of packed lanes by the same shuffle: 2i <-> 2i+1, zeroing indices 0x80 become 0x81 */
+	p = _mm256_xor_si256(p, _mm256_set1_epi8(1));
+#endif
+	p = _mm256_shuffle_epi8(v, p);
+	_mm_storeu_si128((__m128i*)d, _mm256_castsi256_si128(p));
+	d += utf_popcnt32(k & 0xFF);
+	_mm_storeu_si128((__m128i*)d, _mm256_extracti128_si256(p, 1));
+	return d + utf_popcnt32(k >> 8);
+}
+
+/* AVX2 engine: validate and convert blocks of 32 utf8_char_t's,
+  while at least 64 utf8_char_t's remain in the input and there is a space for more than 32 utf16_char_t's:
+ - each block is converted up to the last complete utf8 character in it,
+ - stops before a block containing invalid utf8 character, so the scalar code reports it at exact position,
+ - may store up to 7 garbage utf16_char_t's beyond the (*b), they are overwritten while converting
+  remaining (at least 32) utf8_char_t's.
+ if pad != 0, the input and output buffers are followed by UTF_BUF_PADDING bytes of padding:
+ - converts blocks up to the end of the input, utf8_char_t's read from the padding are replaced by zeros,
+ - converts characters while there is a space for them in the output buffer,
+ - may store garbage utf16_char_t's into the padding of the output buffer.
+ returns pointer beyond the last converted utf8_char_t, updates (*b) */
+UTF_TARGET_AVX2
+static UTF_FORCE_INLINE const utf8_char_t *utf8_to_utf16_avx2_engine(
+	const utf8_char_t *s, const utf8_char_t *const se,
+	UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e, const int pad)
+{
+	UTF16_CHAR_T *d = *b;
+	while (pad ? s != se && (const UTF16_CHAR_T*)d != e :
+		(size_t)(se - s) >= 64 && (size_t)(e - (const UTF16_CHAR_T*)d) > 32)
+	{
+		__m256i v0 = _mm256_loadu_si256((const __m256i*)s);
+		unsigned hi, l = 32; /* l - number of utf8_char_t's of the block that may be converted */
+		if (pad) {
+			const size_t room = (size_t)(e - (const UTF16_CHAR_T*)d);
+			if ((size_t)(se - s) < 32) {
+				l = (unsigned)(se - s);
+				v0 = _mm256_and_si256(v0, _mm256_cmpgt_epi8(_mm256_set1_epi8((char)l), _mm256_setr_epi8(
+					0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+					16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31)));
+			}
+			if (room < l)
+				l = (unsigned)room; /* each utf8_char_t gives at most one utf16_char_t */
+		}
+		hi = (unsigned)_mm256_movemask_epi8(v0);
+		if (!hi) {
+#ifdef SWAP_UTF16
+			/* interleave with zeros, placing ascii bytes into the high bytes of utf16_char_t's */
+			const __m256i x = _mm256_permute4x64_epi64(v0, 0xD8);
+			_mm256_storeu_si256((__m256i*)d, _mm256_unpacklo_epi8(_mm256_setzero_si256(), x));
+			_mm256_storeu_si256((__m256i*)d + 1, _mm256_unpackhi_epi8(_mm256_setzero_si256(), x));
+#else
+			_mm256_storeu_si256((__m256i*)d, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v0)));
+			_mm256_storeu_si256((__m256i*)d + 1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v0, 1)));
+#endif
+			s += l;
+			d += l;
+		}
+		else {
+			const __m256i v1 = _mm256_loadu_si256((const __m256i*)(s + 1));
+			const __m256i v2 = _mm256_loadu_si256((const __m256i*)(s + 2));
+			unsigned cont, ge_e0, ge_f0, r, ls;
+			unsigned n = utf8_avx2_check(v0, v1, hi, &cont, &ge_e0, &ge_f0);
+			if (!n)
+				break; /* invalid or incomplete utf8 character */
+			if (pad && n > l) {
+				/* zeros read from the padding are complete characters, so the end of the input is
+				  at the beginning of a character, but the output buffer may be filled in the middle of one */
+				n = l;
+				if ((cont >> n) & 1) {
+					/* stop at the first byte of the character, the block starts with a first byte */
+					n = utf_bsr32(~cont & (0xFFFFFFFFu >> (32 - n)));
+					if (!n)
+						break; /* no space for the whole utf8 character */
+				}
+			}
+			r = 0xFFFFFFFFu >> (32 - n); /* mask of bytes to process */
+			/* lanes following the first bytes of 4-byte characters will hold low surrogates */
+			ls = (ge_f0 << 1) & r;
+			{
+				/* no more utf16_char_t's than utf8_char_t's, so converted characters fit the output buffer */
+				const unsigned lv = !!(ge_e0 & r) + !!ls;
+				const unsigned k = (~cont & r) | ls;
+				d = utf8_to_utf16_avx2_pack(d, utf8_to_utf16_avx2_decode(
+					_mm256_cvtepu8_epi16(_mm256_castsi256_si128(v0)),
+					_mm256_cvtepu8_epi16(_mm256_castsi256_si128(v1)),
+					_mm256_cvtepu8_epi16(_mm256_castsi256_si128(v2)), lv, ls & 0xFFFF), k & 0xFFFF);
+				d = utf8_to_utf16_avx2_pack(d, utf8_to_utf16_avx2_decode(
+					_mm256_cvtepu8_epi16(_mm256_extracti128_si256(v0, 1)),
+					_mm256_cvtepu8_epi16(_mm256_extracti128_si256(v1, 1)),
+					_mm256_cvtepu8_epi16(_mm256_extracti128_si256(v2, 1)), lv, ls >> 16), k >> 16);
+			}
+			s += n;
+		}
+	}
+	*b = d;
+	return s;
+}
+
+UTF_TARGET_AVX2
+static const utf8_char_t *utf8_to_utf16_avx2(
+	const utf8_char_t *s, const utf8_char_t *const se,
+	UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	return utf8_to_utf16_avx2_engine(s, se, b, e, /*pad:*/0);
+}
+
+UTF_TARGET_AVX2
+static const utf8_char_t *utf8_to_utf16_avx2_pad(
+	const utf8_char_t *s, const utf8_char_t *const se,
+	UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	return utf8_to_utf16_avx2_engine(s, se, b, e, /*pad:*/1);
+}
+
+/* size of a window, in which the terminating 0 is searched before converting its part by the AVX2 engine */
+#define UTF8_Z_WINDOW 4096
+
+/* AVX2 engine for 0-terminated utf8 string: convert its parts known not to contain the terminating 0 */
+static const utf8_char_t *utf8_to_utf16_z_avx2(
+	const utf8_char_t *s, UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	const utf8_char_t *z = s;
+	for (;;) {
+		const utf8_char_t *const p = (const utf8_char_t*)memchr(z, 0, UTF8_Z_WINDOW);
+		z = p ? p : z + UTF8_Z_WINDOW;
+		s = utf8_to_utf16_avx2(s, z, b, e);
+		if (p || (size_t)(z - s) >= 64)
+			return s; /* 0 was found or the engine has stopped not because of the window end */
+	}
+}
+
+/* strings shorter than this are converted by the short-string kernel */
+#define UTF8_AVX2_SHORT 32
+
+/* shorter strings of non-ascii characters are converted faster by the scalar code */
+#define UTF8_AVX2_SHORT_MIXED 16
+
+/* strings converted by the AVX-512 engine are not passed to the short-string kernel */
+#ifdef UTF8_TO_UTF16_AVX512
+#define UTF8_AVX2_SHORT_USE(n) ((n) < UTF8_AVX512_MIN || !(libutf16_cpu_features() & UTF_CPU_AVX512))
+#else
+#define UTF8_AVX2_SHORT_USE(n) 1
+#endif
+
+/* short-string kernel: validate and convert n < UTF8_AVX2_SHORT utf8_char_t's at once,
+  there must be a space for n utf16_char_t's in the output buffer (the worst case),
+  bytes beyond the converted utf16_char_t's are not touched,
+  if mixed is zero, converts only a string of ascii characters,
+  returns the number of stored utf16_char_t's, 0 - if the string was not converted */
+UTF_TARGET_AVX2
+static unsigned utf8_to_utf16_avx2_short(
+	const utf8_char_t *const s, const unsigned n/*>0*/, UTF16_CHAR_T *const d, const int mixed)
+{
+	const __m256i v0 = utf_avx2_load_short(s, n);
+	const unsigned hi = (unsigned)_mm256_movemask_epi8(v0);
+	__m256i x, y; /* converted utf16_char_t's: first 16 and the next ones */
+	unsigned l = n; /* number of them */
+	if (!hi) {
+		x = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(v0));
+		y = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(v0, 1));
+#ifdef SWAP_UTF16
+		x = _mm256_slli_epi16(x, 8);
+		y = _mm256_slli_epi16(y, 8);
+#endif
+	}
+	else if (!mixed)
+		return 0;
+	else {
+		/* zeros following the string are complete characters, so an incomplete one at its end is invalid */
+		const __m256i v1 = utf_avx2_shift_short(v0, 1);
+		const __m256i v2 = utf_avx2_shift_short(v0, 2);
+		const unsigned r = 0xFFFFFFFFu >> (32 - n); /* mask of bytes to process */
+		unsigned cont, ge_e0, ge_f0;
+		if (utf8_avx2_check(v0, v1, hi, &cont, &ge_e0, &ge_f0) < n)
+			return 0; /* invalid or incomplete utf8 character */
+		{
+			/* lanes following the first bytes of 4-byte characters will hold low surrogates */
+			const unsigned ls = (ge_f0 << 1) & r;
+			const unsigned lv = !!(ge_e0 & r) + !!ls;
+			const unsigned k = (~cont & r) | ls;
+			UTF16_CHAR_T t[40], *p;
+			p = utf8_to_utf16_avx2_pack(t, utf8_to_utf16_avx2_decode(
+				_mm256_cvtepu8_epi16(_mm256_castsi256_si128(v0)),
+				_mm256_cvtepu8_epi16(_mm256_castsi256_si128(v1)),
+				_mm256_cvtepu8_epi16(_mm256_castsi256_si128(v2)), lv, ls & 0xFFFF), k & 0xFFFF);
+			p = utf8_to_utf16_avx2_pack(p, utf8_to_utf16_avx2_decode(
+				_mm256_cvtepu8_epi16(_mm256_extracti128_si256(v0, 1)),
+				_mm256_cvtepu8_epi16(_mm256_extracti128_si256(v1, 1)),
+				_mm256_cvtepu8_epi16(_mm256_extracti128_si256(v2, 1)), lv, ls >> 16), k >> 16);
+			l = (unsigned)(p - t);
+			x = _mm256_loadu_si256((const __m256i*)t);
+			y = _mm256_loadu_si256((const __m256i*)(t + 16));
+		}
+	}
+	utf_avx2_store_short(d, x, (l < 16 ? l : 16)*(unsigned)sizeof(*d));
+	if (l > 16)
+		utf_avx2_store_short(d + 16, y, (l - 16)*(unsigned)sizeof(*d));
+	return l;
+}
+
+#endif /* LIBUTF16_AVX2 */
+
+/* convert a run of ascii characters, 8 utf8_char_t's at a time,
+  there must be more than 8 utf8_char_t's in the source buffer and more than 8 free utf16_char_t's in the destination,
+  returns pointer to the first non-converted utf8_char_t, at least one utf8_char_t and one free utf16_char_t are left */
+static const utf8_char_t *utf8_to_utf16_ascii(
+	const utf8_char_t *s, const utf8_char_t *const se,
+	UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	UTF16_CHAR_T *d = *b;
+	size_t n = (size_t)(se - s);
+	if (n > (size_t)(e - (const UTF16_CHAR_T*)d))
+		n = (size_t)(e - (const UTF16_CHAR_T*)d);
+	do {
+		const utf_word64_t w = utf_load64(s);
+		utf8_char_t c[8];
+		unsigned i = 0;
+		if (w & UTF8_SWAR_NOT_ASCII) {
+			/* convert ascii characters before the non-ascii one */
+			while (s[i] < 0x80) {
+				UTF16_PUT(d + i, (utf16_char_t)s[i]);
+				i++;
+			}
+			s += i;
+			d += i;
+			break;
+		}
+		memcpy(c, &w, sizeof(c));
+		for (; i < 8; i++)
+			UTF16_PUT(d + i, (utf16_char_t)c[i]);
+		s += 8;
+		d += 8;
+		n -= 8;
+	} while (n > 8);
+	*b = d;
+	return s;
+}
+
+#ifdef LIBUTF16_UTF8_DFA
+
+/* DFA decoder: store utf16 character(s) of the code point decoded so far, if it is complete,
+  advance the destination pointer - by 2 for a surrogate pair, there must be space for 2 utf16_char_t's */
+#define UTF8_TO_UTF16_DFA_PUT(d, st, c) do { \
+	const unsigned a_ = UTF8_DFA_ACCEPT == UTF8_DFA_STATE(st), p_ = (c) > 0xFFFF; \
+	const unsigned h_ = ((c) >> 10) + 0xD7C0; \
+	UTF16_PUT(d, (utf16_char_t)(p_ ? h_ : (c)));              /* 110110aaaabbbbbb */ \
+	UTF16_PUT(d + 1, (utf16_char_t)(((c) & 0x3FF) + 0xDC00)); /* 110111bbcccccccc */ \
+	d += a_ + (a_ & p_); \
+} while (0)
+
+/* DFA decoder: validate and convert blocks of 8 utf8_char_t's, while more than 8 of them remain in the input
+  and there is more than 9 free utf16_char_t's in the destination (a block gives up to 8 characters - at most
+  9 utf16_char_t's, if the first one completes a 4-byte character started in the previous block, then one more
+  utf16_char_t may be stored unconditionally),
+ - runs of ascii characters are converted by 8 utf8_char_t's at a time,
+ - rejecting state is checked once per block: the decoder then stops at the start of invalid utf8 character,
+   so the scalar code reports it at exact position,
+ - may store up to 2 garbage utf16_char_t's beyond the (*b).
+ returns pointer to the first non-converted utf8_char_t, which starts a utf8 character,
+ at least one utf8_char_t is left */
+static const utf8_char_t *utf8_to_utf16_dfa(
+	const utf8_char_t *s, const utf8_char_t *const se,
+	UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	UTF16_CHAR_T *d = *b;
+	const utf8_char_t *t = s; /* start of the last utf8 character */
+	utf_word64_t st = UTF8_DFA_ACCEPT;
+	unsigned c = 0;
+	while ((size_t)(se - s) > 8 && (size_t)(e - (const UTF16_CHAR_T*)d) > 9) {
+		const utf_word64_t w = utf_load64(s);
+		unsigned i = 0;
+		if (UTF8_DFA_ACCEPT == UTF8_DFA_STATE(st) && !(w & UTF8_SWAR_NOT_ASCII)) {
+			utf8_char_t a[8];
+			memcpy(a, &w, sizeof(a));
+			for (; i < 8; i++)
+				UTF16_PUT(d + i, (utf16_char_t)a[i]);
+			d += 8;
+		}
+		else {
+			for (; i < 8; i++) {
+				t += (size_t)(s + i - t) & utf8_dfa_step(&st, &c, s[i]);
+				UTF8_TO_UTF16_DFA_PUT(d, st, c);
+			}
+			if (UTF8_DFA_REJECT == UTF8_DFA_STATE(st))
+				break; /* invalid utf8 character */
+		}
+		s += 8;
+	}
+	*b = d;
+	/* invalid or incomplete utf8 character is left to the scalar code */
+	return UTF8_DFA_ACCEPT == UTF8_DFA_STATE(st) ? s : t;
+}
+
+/* DFA decoder for 0-terminated utf8 string: validate and convert its part before the terminating 0,
+  while there is more than 9 free utf16_char_t's in the destination, may store garbage beyond the (*b) - as the above,
+  returns pointer to the first non-converted utf8_char_t, which starts a utf8 character (possibly the 0) */
+static const utf8_char_t *utf8_to_utf16_z_dfa(
+	const utf8_char_t *s,
+	UTF16_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF16_CHAR_T *const e)
+{
+	UTF16_CHAR_T *d = *b;
+	const utf8_char_t *t = s; /* start of the last utf8 character */
+	utf_word64_t st = UTF8_DFA_ACCEPT;
+	unsigned c = 0;
+	while ((size_t)(e - (const UTF16_CHAR_T*)d) > 9) {
+		unsigned i = 0;
+		for (; i < 8; i++) {
+			const unsigned x = s[i];
+			if (!x) {
+				s += i;
+				goto done; /* the terminating 0 (or incomplete utf8 character before it) is left to the scalar code */
+			}
+			t += (size_t)(s + i - t) & utf8_dfa_step(&st, &c, x);
+			UTF8_TO_UTF16_DFA_PUT(d, st, c);
+		}
+		s += 8;
+		if (UTF8_DFA_REJECT == UTF8_DFA_STATE(st))
+			break; /* invalid utf8 character */
+	}
+done:
+	*b = d;
+	/* invalid or incomplete utf8 character is left to the scalar code */
+	return UTF8_DFA_ACCEPT == UTF8_DFA_STATE(st) ? s : t;
+}
+
+#endif /* LIBUTF16_UTF8_DFA */
+
 /*
  utf8_to_utf16_z_
  utf8_to_utf16x_z_
@@ -62,6 +629,20 @@ size_t UTF_FORM_NAME(_z_)(
 	else {
 		UTF16_CHAR_T *LIBUTF16_RESTRICT d = *b;
 		const UTF16_CHAR_T *const e = (const UTF16_CHAR_T*)d + sz;
+#ifdef UTF8_TO_UTF16_AVX512
+		if (libutf16_cpu_features() & UTF_CPU_AVX512)
+			s = utf8_to_utf16_z_avx512(s, &d, e);
+#ifdef UTF8_TO_UTF16_AVX2
+		else
+#endif
+#endif
+#ifdef UTF8_TO_UTF16_AVX2
+		if (sz > 32 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+			s = utf8_to_utf16_z_avx2(s, &d, e);
+#endif
+#ifdef LIBUTF16_UTF8_DFA
+		s = utf8_to_utf16_z_dfa(s, &d, e);
+#endif
 		do {
 			unsigned a = s[0];
 			if (a >= 0x80) {
@@ -75,7 +656,7 @@ size_t UTF_FORM_NAME(_z_)(
 						goto bad_utf8; /* incomplete utf8 character */
 					a = (a << 6) + r;
 					if (a >= (((0xF0 << 6) + 0x80) << 6) + 0x80) {
-						if (a > (((0xF4 << 6) + 0x80) << 6) + 0x80)
+						if (a > (((0xF4 << 6) + 0xBF) << 6) + 0xBF)
 							goto bad_utf8; /* unicode code point must be <= 0x10FFFF */
 						if (!((0x3C90 << 6) + 0x80 <= a && a <= (0x3D8F << 6) + 0xBF))
 							goto bad_utf8; /* overlong utf8 character/out of range */
@@ -127,6 +708,15 @@ small_buf:
 			return sz + 1 + m; /* ok, >0, but > dst buffer size */
 		}
 	}
+#ifdef LIBUTF16_AVX2
+	{
+		/* size-only pass: each continuation byte reduces the number of resulting utf16_char_t's,
+		  except the ones of 4-byte characters, which are converted to surrogate pairs */
+		size_t c = 0, f = 0;
+		s = libutf16_utf8_count_z(s, &c, &f);
+		m += c - f;
+	}
+#endif
 	for (;;) {
 		unsigned a = s[0];
 		if (a >= 0x80) {
@@ -139,7 +729,7 @@ small_buf:
 					goto bad_utf8_s; /* incomplete utf8 character */
 				a = (a << 6) + r;
 				if (a >= (0xF0 << 6) + 0x80) {
-					if (a > (0xF4 << 6) + 0x80)
+					if (a > (0xF4 << 6) + 0xBF)
 						goto bad_utf8_s; /* unicode code point must be <= 0x10FFFF */
 					if (!(0x3C90 <= a && a <= 0x3D8F))
 						goto bad_utf8_s; /* overlong utf8 character/out of range */
@@ -211,6 +801,37 @@ size_t UTF_FORM_NAME(_)(
 		else {
 			UTF16_CHAR_T *LIBUTF16_RESTRICT d = *b;
 			const UTF16_CHAR_T *const e = (const UTF16_CHAR_T*)d + sz;
+#ifdef UTF8_TO_UTF16_AVX2
+			if (n > 1 && n < UTF8_AVX2_SHORT && sz >= n && (libutf16_cpu_features() & UTF_CPU_AVX2) &&
+				UTF8_AVX2_SHORT_USE(n))
+			{
+				m = utf8_to_utf16_avx2_short(s, (unsigned)n, d, n >= UTF8_AVX2_SHORT_MIXED);
+				if (m) {
+					s = se;
+					d += m;
+					goto bad_utf8; /* ok, all utf8_char_t's were converted */
+				}
+			}
+#endif
+#ifdef UTF8_TO_UTF16_AVX512
+			if (n >= UTF8_AVX512_MIN && (libutf16_cpu_features() & UTF_CPU_AVX512)) {
+				s = utf8_to_utf16_avx512(s, se, &d, e);
+				if (se == s) {
+					m = (size_t)(d - *b);
+					goto bad_utf8; /* ok, all utf8_char_t's were converted */
+				}
+			}
+#ifdef UTF8_TO_UTF16_AVX2
+			else
+#endif
+#endif
+#ifdef UTF8_TO_UTF16_AVX2
+			if (libutf16_cpu_features() & UTF_CPU_AVX2)
+				s = utf8_to_utf16_avx2(s, se, &d, e);
+#endif
+#ifdef LIBUTF16_UTF8_DFA
+			s = utf8_to_utf16_dfa(s, se, &d, e);
+#endif
 			do {
 				unsigned a = s[0];
 				if (a >= 0x80) {
@@ -235,12 +856,9 @@ size_t UTF_FORM_NAME(_)(
 							if (0x80 != (r & 0xC0))
 								goto bad_utf8; /* incomplete utf8 character */
 							a = (a << 6) + r - 0x682080 - 0x10000;
+							if ((const UTF16_CHAR_T*)d + 1 == e)
+								break; /* too small output buffer, utf8 character will be counted again */
 							s += 4;
-							if ((const UTF16_CHAR_T*)d + 1 == e) {
-								t = s - 4;
-								m = 2; /* = (4 utf8_char_t's - 2 utf16_char_t's) */
-								goto small_buf; /* too small output buffer */
-							}
 							UTF16_PUT(d++, (utf16_char_t)(a >> 10)); /* 110110aaaabbbbbb */
 							a = (a & 0x3FF) + 0xDC00;                /* 110111bbcccccccc */
 						}
@@ -272,6 +890,10 @@ size_t UTF_FORM_NAME(_)(
 					else
 						goto bad_utf8; /* not expecting 10xxxxxx or overlong utf8 character: 1100000x */
 				}
+				else if ((size_t)(se - s) > 8 && (size_t)(e - (const UTF16_CHAR_T*)d) > 8 && s[1] < 0x80) {
+					s = utf8_to_utf16_ascii(s, se, &d, e);
+					continue; /* (d != e) */
+				}
 				else
 					s++;
 				UTF16_PUT(d++, (utf16_char_t)a);
@@ -285,14 +907,22 @@ bad_utf8:
 			} while ((const UTF16_CHAR_T*)d != e);
 			/* too small output buffer */
 			t = s;
-small_buf:
 			sz = (size_t)(d - *b);
 			*b = d;
 			if (!determ_size) {
 				*q = t; /* points after the last successfully converted utf8_char_t, (*q) < se */
-				return sz + 1 + m; /* ok, >0, but > dst buffer size */
+				return sz + 2; /* ok, >0, but > dst buffer size (there may be no space for a surrogate pair) */
 			}
 		}
+#ifdef LIBUTF16_AVX2
+		if ((size_t)(se - s) > 64) {
+			/* size-only pass: each continuation byte reduces the number of resulting utf16_char_t's,
+			  except the ones of 4-byte characters, which are converted to surrogate pairs */
+			size_t c = 0, f = 0;
+			s = libutf16_utf8_count(s, se, &c, &f);
+			m += c - f;
+		}
+#endif
 		do {
 			unsigned a = s[0];
 			if (a >= 0x80) {
@@ -368,6 +998,224 @@ bad_utf8_s:
 	return 0; /* n is zero */
 }
 
+#ifndef UTF_PUT_UNALIGNED
+/*
+ utf8_to_utf16_alloc
+ utf8_to_utf16x_alloc
+*/
+size_t UTF_FORM_NAME(_alloc)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	UTF16_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t n, const int shrink)
+{
+	UTF16_CHAR_T *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	buf = (UTF16_CHAR_T*)utf_alloc_buf(UTF8_TO_UTF16_MAX(n), sizeof(*buf));
+	if (!buf)
+		return (size_t)-1; /* not enough memory */
+	d = buf;
+	/* the output buffer is large enough, so the conversion may only fail on invalid input */
+	m = UTF_FORM_NAME(_)(q, &d, UTF8_TO_UTF16_MAX(n), n, /*determ_size:*/0);
+	if (!m) {
+		free(buf);
+		return 0; /* invalid utf8 string */
+	}
+	if (shrink && m < UTF8_TO_UTF16_MAX(n))
+		buf = (UTF16_CHAR_T*)utf_shrink_buf(buf, m*sizeof(*buf));
+	*b = buf;
+	return m;
+}
+
+/*
+ utf8_to_utf16_arena
+ utf8_to_utf16x_arena
+*/
+size_t UTF_FORM_NAME(_arena)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	UTF16_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t n, utf_arena_t *const LIBUTF16_RESTRICT a)
+{
+	UTF16_CHAR_T *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	if (n <= a->chunk_size/sizeof(*buf)/UTF8_TO_UTF16_MAX(1)) {
+		/* worst-case size fits in a chunk: allocate it and then return unused tail to the arena */
+		buf = (UTF16_CHAR_T*)utf_arena_alloc(a, UTF8_TO_UTF16_MAX(n)*sizeof(*buf));
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		/* the output buffer is large enough, so the conversion may only fail on invalid input */
+		m = UTF_FORM_NAME(_)(q, &d, UTF8_TO_UTF16_MAX(n), n, /*determ_size:*/0);
+		utf_arena_trim(a, m ? d : buf);
+		if (!m)
+			return 0; /* invalid utf8 string */
+	}
+	else {
+		/* long string: determine exact size of the output buffer, then convert without validating again */
+		utf_valid_token_t t;
+		m = UTF_FORM_NAME(_size_token)(q, n, &t);
+		if (!m)
+			return 0; /* invalid utf8 string */
+		buf = m <= (size_t)-1/sizeof(*buf) ? (UTF16_CHAR_T*)utf_arena_alloc(a, m*sizeof(*buf)) : NULL;
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		(void)UTF_FORM_NAME(_from_token)(&t, &d, m);
+		*q = (const utf8_char_t*)*q + n;
+	}
+	*b = buf;
+	return m;
+}
+
+/*
+ utf8_to_utf16_grow
+ utf8_to_utf16x_grow
+*/
+size_t UTF_FORM_NAME(_grow)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	utf_grow_buf_t *const LIBUTF16_RESTRICT g,
+	size_t n)
+{
+	const size_t len = g->len;
+	while (n) {
+		if (g->len != g->cap) {
+			const utf8_char_t *const s = *q;
+			UTF16_CHAR_T *const o = (UTF16_CHAR_T*)g->buf + g->len;
+			UTF16_CHAR_T *d = o;
+			const size_t sz = g->cap - g->len;
+			const size_t m = UTF_FORM_NAME(_)(q, &d, sz, n, /*determ_size:*/0);
+			g->len += (size_t)(d - o);
+			if (!m)
+				return 0; /* invalid/incomplete utf8 character */
+			if (m <= sz)
+				return g->len - len; /* ok, all 'n' utf8_char_t's were converted */
+			/* output buffer is full, continue from the last converted utf8_char_t */
+			n -= (size_t)(*q - s);
+		}
+		/* each of remaining utf8_char_t's produces at most one utf16_char_t */
+		if (!utf_grow_buf(g, n, sizeof(UTF16_CHAR_T)))
+			return (size_t)-1; /* not enough memory */
+	}
+	return 0; /* n is zero */
+}
+#endif
+
+/*
+ utf8_to_utf16_size_token
+ utf8_to_utf16x_size_token
+ utf8_to_utf16u_size_token
+ utf8_to_utf16ux_size_token
+*/
+size_t UTF_FORM_NAME(_size_token)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	const size_t n,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const size_t sz = UTF_FORM_NAME(_)(q, /*b:*/NULL, /*sz:*/0, n, /*determ_size:*/1);
+	t->src = sz ? *q : NULL;
+	t->n = sz ? n : 0;
+	t->size = sz;
+	t->kind = sz ? UTF_TOKEN_KIND : 0;
+	return sz;
+}
+
+/*
+ utf8_to_utf16_z_size_token
+ utf8_to_utf16x_z_size_token
+ utf8_to_utf16u_z_size_token
+ utf8_to_utf16ux_z_size_token
+*/
+size_t UTF_FORM_NAME(_z_size_token)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const utf8_char_t *const s = *q;
+	const size_t sz = UTF_FORM_NAME(_z_)(q, /*b:*/NULL, /*sz:*/0, /*determ_size:*/2);
+	if (!sz) {
+		t->src = NULL;
+		t->n = 0;
+		t->size = 0;
+		t->kind = 0;
+		return 0; /* invalid utf8 string */
+	}
+	t->src = s;
+	t->n = (size_t)(*q - s);
+	t->size = sz;
+	t->kind = UTF_TOKEN_KIND;
+	*q = s; /* (*q) was moved beyond the 0-terminator */
+	return sz;
+}
+
+/*
+ utf8_to_utf16_from_token
+ utf8_to_utf16x_from_token
+ utf8_to_utf16u_from_token
+ utf8_to_utf16ux_from_token
+*/
+size_t UTF_FORM_NAME(_from_token)(
+	const utf_valid_token_t *const LIBUTF16_RESTRICT t,
+	UTF16_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t sz)
+{
+	if (t->kind != UTF_TOKEN_KIND)
+		return 0; /* the token is empty or was filled by another conversion */
+	if (t->size > sz)
+		return t->size; /* output buffer is too small */
+#ifdef UTF8_TO_UTF16_AVX2
+	if (libutf16_cpu_features() & UTF_CPU_AVX2) {
+		/* the engine validates the string nearly for free and is faster than the unchecked scalar code */
+		const utf8_char_t *q = (const utf8_char_t*)t->src;
+		return UTF_FORM_NAME(_)(&q, b, t->size, t->n, /*determ_size:*/0);
+	}
+#endif
+	UTF_FORM_NAME(_unsafe)((const utf8_char_t*)t->src, *b, t->n);
+	*b += t->size;
+	return t->size;
+}
+
+/*
+ utf8_to_utf16_pad_
+ utf8_to_utf16u_pad_
+ utf8_to_utf16x_pad_
+ utf8_to_utf16ux_pad_
+*/
+size_t UTF_FORM_NAME(_pad_)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	UTF16_CHAR_T **const LIBUTF16_RESTRICT b,
+	size_t sz, const size_t n, const int determ_size)
+{
+#ifdef UTF8_TO_UTF16_AVX2
+	/* the AVX-512 engine does not need the padding: it uses masked loads and stores */
+	if (n && sz &&
+#ifdef UTF8_TO_UTF16_AVX512
+		(n < UTF8_AVX512_MIN || !(libutf16_cpu_features() & UTF_CPU_AVX512)) &&
+#endif
+		(libutf16_cpu_features() & UTF_CPU_AVX2))
+	{
+		UTF16_CHAR_T *LIBUTF16_RESTRICT d = *b;
+		const utf8_char_t *const s = utf8_to_utf16_avx2_pad(*q, *q + n, &d, (const UTF16_CHAR_T*)d + sz);
+		const size_t k = (size_t)(s - *q);
+		if (k) {
+			/* the engine stops only at the end of the input, if the output buffer
+			  is full, or before invalid/incomplete utf8 character */
+			const size_t m = (size_t)(d - *b);
+			*q = s;
+			*b = d;
+			if (n == k)
+				return m; /* ok, all utf8_char_t's were converted */
+			sz = UTF_FORM_NAME(_)(q, b, sz - m, n - k, determ_size);
+			return sz ? m + sz : 0;
+		}
+	}
+#endif
+	return UTF_FORM_NAME(_)(q, b, sz, n, determ_size);
+}
+
 /*
  utf8_to_utf16_z_unsafe
  utf8_to_utf16x_z_unsafe
@@ -462,6 +1310,10 @@ void UTF_FORM_NAME(_unsafe)(
 				q += 2;
 			}
 		}
+		else if ((size_t)(qe - q) > 8 && q[1] < 0x80) {
+			q = utf8_to_utf16_ascii(q, qe, &b, (const UTF16_CHAR_T*)b + (qe - q));
+			continue; /* (q != qe) */
+		}
 		else
 			q++;
 		UTF16_PUT(b++, (utf16_char_t)a);
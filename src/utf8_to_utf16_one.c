@@ -224,7 +224,7 @@ const utf8_char_t *utf8_to_utf32_one_z(
 				return NULL; /* incomplete utf8 character */
 			a = (a << 6) + r;
 			if (a >= (((0xF0 << 6) + 0x80) << 6) + 0x80) {
-				if (a > (((0xF4 << 6) + 0x80) << 6) + 0x80)
+				if (a > (((0xF4 << 6) + 0xBF) << 6) + 0xBF)
 					return NULL; /* unicode code point must be <= 0x10FFFF */
 				if (!((0x3C90 << 6) + 0x80 <= a && a <= (0x3D8F << 6) + 0xBF))
 					return NULL; /* overlong utf8 character/out of range */
@@ -16,12 +16,15 @@
 #include <stdlib.h> /* for _byteswap_ushort()/_byteswap_ulong() */
 #endif
 
-#include <memory.h> /* for memcpy() */
+#include <memory.h> /* for memcpy()/memchr() */
 
 #include "libutf16/utf8_to_utf32.h"
 #include "libutf16/utf16_swap.h"
 
 #include "utf16_internal.h"
+#include "utf16_simd.h"
+#include "utf16_swar.h"
+#include "utf8_dfa.h"
 
 #ifdef _MSC_VER
 #pragma warning(disable:5045) /* Compiler will insert Spectre mitigation for memory load if /Qspectre switch specified */
@@ -37,6 +40,270 @@
 #define UTF_FORM_NAME1(tu, tx, suffix)  UTF_FORM_NAME2(tu, tx, suffix)
 #define UTF_FORM_NAME(suffix)           UTF_FORM_NAME1(UTF_PUT_U, UTF32_X, suffix)
 
+/* kind of tokens of validated strings, filled and accepted by this form of conversion */
+#define UTF_TOKEN_KIND UTF_TOKEN_UTF8_TO_UTF32
+
+#ifdef LIBUTF16_AVX2
+#define UTF8_TO_UTF32_AVX2
+
+/* decode up to 8 utf8 characters starting at s[0]-s[7] to utf32_char_t's and store them to d:
+  lv - 0: there are only 1- and 2-byte characters, 1: there are 3-byte ones, 2: there are 4-byte ones,
+  k - 8-bit mask of the first bytes of characters in s[0]-s[7], only these characters are stored,
+  returns pointer beyond the stored characters, may store up to 8 garbage utf32_char_t's after it */
+UTF_TARGET_AVX2
+static inline UTF32_CHAR_T *utf8_to_utf32_avx2_decode(
+	UTF32_CHAR_T *const d, const utf8_char_t *const s, const unsigned lv, const unsigned k)
+{
+	/* 32-bit lanes: s[i], s[i+1], s[i+2], s[i+3] */
+	const __m256i c = _mm256_shuffle_epi8(
+		_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)s)), _mm256_setr_epi8(
+			0, 1, 2, 3, 1, 2, 3, 4, 2, 3, 4, 5, 3, 4, 5, 6, 4, 5, 6, 7, 5, 6, 7, 8, 6, 7, 8, 9, 7, 8, 9, 10));
+	const __m256i a = _mm256_and_si256(c, _mm256_set1_epi32(0xFF));
+	const __m256i t1 = _mm256_and_si256(_mm256_srli_epi32(c, 8), _mm256_set1_epi32(0x3F));
+	/* 110aaaaa 10bbbbbb -> 00000aaaaabbbbbb */
+	__m256i v = _mm256_blendv_epi8(a,
+		_mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(a, _mm256_set1_epi32(0x1F)), 6), t1),
+		_mm256_cmpgt_epi32(a, _mm256_set1_epi32(0xBF)));
+	if (lv) {
+		const __m256i t2 = _mm256_and_si256(_mm256_srli_epi32(c, 16), _mm256_set1_epi32(0x3F));
+		/* 1110aaaa 10bbbbbb 10cccccc -> aaaabbbbbbcccccc */
+		v = _mm256_blendv_epi8(v,
+			_mm256_or_si256(_mm256_or_si256(
+				_mm256_slli_epi32(_mm256_and_si256(a, _mm256_set1_epi32(0xF)), 12), _mm256_slli_epi32(t1, 6)), t2),
+			_mm256_cmpgt_epi32(a, _mm256_set1_epi32(0xDF)));
+		if (lv > 1) {
+			const __m256i t3 = _mm256_and_si256(_mm256_srli_epi32(c, 24), _mm256_set1_epi32(0x3F));
+			/* 11110aaa 10bbbbbb 10cccccc 10dddddd -> 000aaabbbbbbccccccdddddd */
+			v = _mm256_blendv_epi8(v,
+				_mm256_or_si256(
+					_mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(a, _mm256_set1_epi32(7)), 18), _mm256_slli_epi32(t1, 12)),
+					_mm256_or_si256(_mm256_slli_epi32(t2, 6), t3)),
+				_mm256_cmpgt_epi32(a, _mm256_set1_epi32(0xEF)));
+		}
+	}
+	v = _mm256_permutevar8x32_epi32(v, _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)libutf16_pack32_perm[k])));
+#ifdef SWAP_UTF32
+	v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(
+		3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+#endif
+	_mm256_storeu_si256((__m256i*)d, v);
+	return d + utf_popcnt32(k);
+}
+
+/* AVX2 engine: validate and convert blocks of 32 utf8_char_t's,
+  while at least 64 utf8_char_t's remain in the input and there is a space for at least 40 utf32_char_t's:
+ - each block is converted up to the last complete utf8 character in it,
+ - stops before a block containing invalid utf8 character, so the scalar code reports it at exact position,
+ - may store up to 8 garbage utf32_char_t's beyond the (*b), they are overwritten while converting
+  remaining (at least 32) utf8_char_t's.
+ returns pointer beyond the last converted utf8_char_t, updates (*b) */
+UTF_TARGET_AVX2
+static const utf8_char_t *utf8_to_utf32_avx2(
+	const utf8_char_t *s, const utf8_char_t *const se,
+	UTF32_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF32_CHAR_T *const e)
+{
+	UTF32_CHAR_T *d = *b;
+	while ((size_t)(se - s) >= 64 && (size_t)(e - (const UTF32_CHAR_T*)d) >= 40) {
+		const __m256i v0 = _mm256_loadu_si256((const __m256i*)s);
+		const unsigned hi = (unsigned)_mm256_movemask_epi8(v0);
+		if (!hi) {
+			/* zero-extend 32 one-byte characters */
+			unsigned i = 0;
+			for (; i < 32; i += 8) {
+				__m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(s + i)));
+#ifdef SWAP_UTF32
+				v = _mm256_slli_epi32(v, 24);
+#endif
+				_mm256_storeu_si256((__m256i*)(d + i), v);
+			}
+			s += 32;
+			d += 32;
+		}
+		else {
+			unsigned cont, ge_e0, ge_f0, r;
+			const unsigned n = utf8_avx2_check(v0, _mm256_loadu_si256((const __m256i*)(s + 1)), hi, &cont, &ge_e0, &ge_f0);
+			if (!n)
+				break; /* invalid or incomplete utf8 character */
+			r = 0xFFFFFFFFu >> (32 - n); /* mask of bytes to process */
+			{
+				const unsigned lv = !!(ge_e0 & r) + !!(ge_f0 & r);
+				const unsigned k = ~cont & r;
+				unsigned i = 0;
+				for (; i < 32; i += 8) {
+					if ((k >> i) & 0xFF)
+						d = utf8_to_utf32_avx2_decode(d, s + i, lv, (k >> i) & 0xFF);
+				}
+			}
+			s += n;
+		}
+	}
+	*b = d;
+	return s;
+}
+
+/* size of a window, in which the terminating 0 is searched before converting its part by the AVX2 engine */
+#define UTF8_Z_WINDOW 4096
+
+/* AVX2 engine for 0-terminated utf8 string: convert its parts known not to contain the terminating 0 */
+static const utf8_char_t *utf8_to_utf32_z_avx2(
+	const utf8_char_t *s, UTF32_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF32_CHAR_T *const e)
+{
+	const utf8_char_t *z = s;
+	for (;;) {
+		const utf8_char_t *const p = (const utf8_char_t*)memchr(z, 0, UTF8_Z_WINDOW);
+		z = p ? p : z + UTF8_Z_WINDOW;
+		s = utf8_to_utf32_avx2(s, z, b, e);
+		if (p || (size_t)(z - s) >= 64)
+			return s; /* 0 was found or the engine has stopped not because of the window end */
+	}
+}
+
+/* strings shorter than this are converted by the short-string kernel */
+#define UTF8_AVX2_SHORT 32
+
+/* short-string kernel: convert n < UTF8_AVX2_SHORT utf8_char_t's at once, if all of them are ascii characters,
+  there must be a space for n utf32_char_t's in the output buffer (the worst case),
+  bytes beyond the converted utf32_char_t's are not touched,
+  returns the number of stored utf32_char_t's, 0 - if the string was not converted
+  (non-ascii characters of short strings are faster converted by the scalar code) */
+UTF_TARGET_AVX2
+static unsigned utf8_to_utf32_avx2_short(
+	const utf8_char_t *const s, const unsigned n/*>0*/, UTF32_CHAR_T *const d)
+{
+	utf8_char_t u[32];
+	const __m256i v0 = utf_avx2_load_short(s, n);
+	unsigned i = 0;
+	if (_mm256_movemask_epi8(v0))
+		return 0;
+	_mm256_storeu_si256((__m256i*)u, v0);
+	/* zero-extend one-byte characters */
+	for (; i < n; i += 8) {
+		__m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(u + i)));
+#ifdef SWAP_UTF32
+		v = _mm256_slli_epi32(v, 24);
+#endif
+		utf_avx2_store_short(d + i, v, (n - i < 8 ? n - i : 8)*(unsigned)sizeof(*d));
+	}
+	return n;
+}
+
+#endif /* LIBUTF16_AVX2 */
+
+/* convert a run of ascii characters, 8 utf8_char_t's at a time,
+  there must be more than 8 utf8_char_t's in the source buffer and more than 8 free utf32_char_t's in the destination,
+  returns pointer to the first non-converted utf8_char_t, at least one utf8_char_t and one free utf32_char_t are left */
+static const utf8_char_t *utf8_to_utf32_ascii(
+	const utf8_char_t *s, const utf8_char_t *const se,
+	UTF32_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF32_CHAR_T *const e)
+{
+	UTF32_CHAR_T *d = *b;
+	size_t n = (size_t)(se - s);
+	if (n > (size_t)(e - (const UTF32_CHAR_T*)d))
+		n = (size_t)(e - (const UTF32_CHAR_T*)d);
+	do {
+		const utf_word64_t w = utf_load64(s);
+		utf8_char_t c[8];
+		unsigned i = 0;
+		if (w & UTF8_SWAR_NOT_ASCII) {
+			/* convert ascii characters before the non-ascii one */
+			while (s[i] < 0x80) {
+				UTF32_PUT(d + i, (utf32_char_t)s[i]);
+				i++;
+			}
+			s += i;
+			d += i;
+			break;
+		}
+		memcpy(c, &w, sizeof(c));
+		for (; i < 8; i++)
+			UTF32_PUT(d + i, (utf32_char_t)c[i]);
+		s += 8;
+		d += 8;
+		n -= 8;
+	} while (n > 8);
+	*b = d;
+	return s;
+}
+
+#ifdef LIBUTF16_UTF8_DFA
+
+/* DFA decoder: validate and convert blocks of 8 utf8_char_t's, while more than 8 of them remain in the input
+  and there is more than 8 free utf32_char_t's in the destination (each utf8_char_t gives at most one utf32_char_t),
+ - runs of ascii characters are converted by 8 utf8_char_t's at a time,
+ - rejecting state is checked once per block: the decoder then stops at the start of invalid utf8 character,
+   so the scalar code reports it at exact position,
+ - may store a garbage utf32_char_t beyond the (*b).
+ returns pointer to the first non-converted utf8_char_t, which starts a utf8 character,
+ at least one utf8_char_t is left */
+static const utf8_char_t *utf8_to_utf32_dfa(
+	const utf8_char_t *s, const utf8_char_t *const se,
+	UTF32_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF32_CHAR_T *const e)
+{
+	UTF32_CHAR_T *d = *b;
+	const utf8_char_t *t = s; /* start of the last utf8 character */
+	utf_word64_t st = UTF8_DFA_ACCEPT;
+	unsigned c = 0;
+	while ((size_t)(se - s) > 8 && (size_t)(e - (const UTF32_CHAR_T*)d) > 8) {
+		const utf_word64_t w = utf_load64(s);
+		unsigned i = 0;
+		if (UTF8_DFA_ACCEPT == UTF8_DFA_STATE(st) && !(w & UTF8_SWAR_NOT_ASCII)) {
+			utf8_char_t a[8];
+			memcpy(a, &w, sizeof(a));
+			for (; i < 8; i++)
+				UTF32_PUT(d + i, (utf32_char_t)a[i]);
+			d += 8;
+		}
+		else {
+			for (; i < 8; i++) {
+				t += (size_t)(s + i - t) & utf8_dfa_step(&st, &c, s[i]);
+				UTF32_PUT(d, (utf32_char_t)c);
+				d += UTF8_DFA_ACCEPT == UTF8_DFA_STATE(st);
+			}
+			if (UTF8_DFA_REJECT == UTF8_DFA_STATE(st))
+				break; /* invalid utf8 character */
+		}
+		s += 8;
+	}
+	*b = d;
+	/* invalid or incomplete utf8 character is left to the scalar code */
+	return UTF8_DFA_ACCEPT == UTF8_DFA_STATE(st) ? s : t;
+}
+
+/* DFA decoder for 0-terminated utf8 string: validate and convert its part before the terminating 0,
+  while there is more than 8 free utf32_char_t's in the destination, may store garbage beyond the (*b) - as the above,
+  returns pointer to the first non-converted utf8_char_t, which starts a utf8 character (possibly the 0) */
+static const utf8_char_t *utf8_to_utf32_z_dfa(
+	const utf8_char_t *s,
+	UTF32_CHAR_T *LIBUTF16_RESTRICT *const b, const UTF32_CHAR_T *const e)
+{
+	UTF32_CHAR_T *d = *b;
+	const utf8_char_t *t = s; /* start of the last utf8 character */
+	utf_word64_t st = UTF8_DFA_ACCEPT;
+	unsigned c = 0;
+	while ((size_t)(e - (const UTF32_CHAR_T*)d) > 8) {
+		unsigned i = 0;
+		for (; i < 8; i++) {
+			const unsigned x = s[i];
+			if (!x) {
+				s += i;
+				goto done; /* the terminating 0 (or incomplete utf8 character before it) is left to the scalar code */
+			}
+			t += (size_t)(s + i - t) & utf8_dfa_step(&st, &c, x);
+			UTF32_PUT(d, (utf32_char_t)c);
+			d += UTF8_DFA_ACCEPT == UTF8_DFA_STATE(st);
+		}
+		s += 8;
+		if (UTF8_DFA_REJECT == UTF8_DFA_STATE(st))
+			break; /* invalid utf8 character */
+	}
+done:
+	*b = d;
+	/* invalid or incomplete utf8 character is left to the scalar code */
+	return UTF8_DFA_ACCEPT == UTF8_DFA_STATE(st) ? s : t;
+}
+
+#endif /* LIBUTF16_UTF8_DFA */
+
 /*
  utf8_to_utf32_z_
  utf8_to_utf32x_z_
@@ -62,6 +329,13 @@ size_t UTF_FORM_NAME(_z_)(
 	else {
 		UTF32_CHAR_T *LIBUTF16_RESTRICT d = *b;
 		const UTF32_CHAR_T *const e = (const UTF32_CHAR_T*)d + sz;
+#ifdef UTF8_TO_UTF32_AVX2
+		if (sz >= 40 && (libutf16_cpu_features() & UTF_CPU_AVX2))
+			s = utf8_to_utf32_z_avx2(s, &d, e);
+#endif
+#ifdef LIBUTF16_UTF8_DFA
+		s = utf8_to_utf32_z_dfa(s, &d, e);
+#endif
 		do {
 			unsigned a = s[0];
 			if (a >= 0x80) {
@@ -75,7 +349,7 @@ size_t UTF_FORM_NAME(_z_)(
 						goto bad_utf8; /* incomplete utf8 character */
 					a = (a << 6) + r;
 					if (a >= (((0xF0 << 6) + 0x80) << 6) + 0x80) {
-						if (a > (((0xF4 << 6) + 0x80) << 6) + 0x80)
+						if (a > (((0xF4 << 6) + 0xBF) << 6) + 0xBF)
 							goto bad_utf8; /* unicode code point must be <= 0x10FFFF */
 						if (!((0x3C90 << 6) + 0x80 <= a && a <= (0x3D8F << 6) + 0xBF))
 							goto bad_utf8; /* overlong utf8 character/out of range */
@@ -119,6 +393,14 @@ bad_utf8:
 			return sz + 1; /* ok, >0, but > dst buffer size */
 		}
 	}
+#ifdef LIBUTF16_AVX2
+	{
+		/* size-only pass: each continuation byte reduces the number of resulting utf32_char_t's */
+		size_t c = 0, f = 0;
+		s = libutf16_utf8_count_z(s, &c, &f);
+		m += c;
+	}
+#endif
 	for (;;) {
 		unsigned a = s[0];
 		if (a >= 0x80) {
@@ -131,7 +413,7 @@ bad_utf8:
 					goto bad_utf8_s; /* incomplete utf8 character */
 				a = (a << 6) + r;
 				if (a >= (0xF0 << 6) + 0x80) {
-					if (a > (0xF4 << 6) + 0x80)
+					if (a > (0xF4 << 6) + 0xBF)
 						goto bad_utf8_s; /* unicode code point must be <= 0x10FFFF */
 					if (!(0x3C90 <= a && a <= 0x3D8F))
 						goto bad_utf8_s; /* overlong utf8 character/out of range */
@@ -203,6 +485,21 @@ size_t UTF_FORM_NAME(_)(
 		else {
 			UTF32_CHAR_T *LIBUTF16_RESTRICT d = *b;
 			const UTF32_CHAR_T *const e = (const UTF32_CHAR_T*)d + sz;
+#ifdef UTF8_TO_UTF32_AVX2
+			if (n > 1 && n < UTF8_AVX2_SHORT && sz >= n && (libutf16_cpu_features() & UTF_CPU_AVX2)) {
+				m = utf8_to_utf32_avx2_short(s, (unsigned)n, d);
+				if (m) {
+					s = se;
+					d += m;
+					goto bad_utf8; /* ok, all utf8_char_t's were converted */
+				}
+			}
+			if (libutf16_cpu_features() & UTF_CPU_AVX2)
+				s = utf8_to_utf32_avx2(s, se, &d, e);
+#endif
+#ifdef LIBUTF16_UTF8_DFA
+			s = utf8_to_utf32_dfa(s, se, &d, e);
+#endif
 			do {
 				unsigned a = s[0];
 				if (a >= 0x80) {
@@ -257,6 +554,10 @@ size_t UTF_FORM_NAME(_)(
 					else
 						goto bad_utf8; /* not expecting 10xxxxxx or overlong utf8 character: 1100000x */
 				}
+				else if ((size_t)(se - s) > 8 && (size_t)(e - (const UTF32_CHAR_T*)d) > 8 && s[1] < 0x80) {
+					s = utf8_to_utf32_ascii(s, se, &d, e);
+					continue; /* (d != e) */
+				}
 				else
 					s++;
 				UTF32_PUT(d++, (utf32_char_t)a);
@@ -277,6 +578,14 @@ bad_utf8:
 				return sz + 1; /* ok, >0, but > dst buffer size */
 			}
 		}
+#ifdef LIBUTF16_AVX2
+		if ((size_t)(se - s) > 64) {
+			/* size-only pass: each continuation byte reduces the number of resulting utf32_char_t's */
+			size_t c = 0, f = 0;
+			s = libutf16_utf8_count(s, se, &c, &f);
+			m += c;
+		}
+#endif
 		do {
 			unsigned a = s[0];
 			if (a >= 0x80) {
@@ -352,6 +661,186 @@ bad_utf8_s:
 	return 0; /* n is zero */
 }
 
+#ifndef UTF_PUT_UNALIGNED
+/*
+ utf8_to_utf32_alloc
+ utf8_to_utf32x_alloc
+*/
+size_t UTF_FORM_NAME(_alloc)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	UTF32_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t n, const int shrink)
+{
+	UTF32_CHAR_T *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	buf = (UTF32_CHAR_T*)utf_alloc_buf(UTF8_TO_UTF32_MAX(n), sizeof(*buf));
+	if (!buf)
+		return (size_t)-1; /* not enough memory */
+	d = buf;
+	/* the output buffer is large enough, so the conversion may only fail on invalid input */
+	m = UTF_FORM_NAME(_)(q, &d, UTF8_TO_UTF32_MAX(n), n, /*determ_size:*/0);
+	if (!m) {
+		free(buf);
+		return 0; /* invalid utf8 string */
+	}
+	if (shrink && m < UTF8_TO_UTF32_MAX(n))
+		buf = (UTF32_CHAR_T*)utf_shrink_buf(buf, m*sizeof(*buf));
+	*b = buf;
+	return m;
+}
+
+/*
+ utf8_to_utf32_arena
+ utf8_to_utf32x_arena
+*/
+size_t UTF_FORM_NAME(_arena)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	UTF32_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t n, utf_arena_t *const LIBUTF16_RESTRICT a)
+{
+	UTF32_CHAR_T *buf, *d;
+	size_t m;
+	*b = NULL;
+	if (!n)
+		return 0; /* n is zero */
+	if (n <= a->chunk_size/sizeof(*buf)/UTF8_TO_UTF32_MAX(1)) {
+		/* worst-case size fits in a chunk: allocate it and then return unused tail to the arena */
+		buf = (UTF32_CHAR_T*)utf_arena_alloc(a, UTF8_TO_UTF32_MAX(n)*sizeof(*buf));
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		/* the output buffer is large enough, so the conversion may only fail on invalid input */
+		m = UTF_FORM_NAME(_)(q, &d, UTF8_TO_UTF32_MAX(n), n, /*determ_size:*/0);
+		utf_arena_trim(a, m ? d : buf);
+		if (!m)
+			return 0; /* invalid utf8 string */
+	}
+	else {
+		/* long string: determine exact size of the output buffer, then convert without validating again */
+		utf_valid_token_t t;
+		m = UTF_FORM_NAME(_size_token)(q, n, &t);
+		if (!m)
+			return 0; /* invalid utf8 string */
+		buf = m <= (size_t)-1/sizeof(*buf) ? (UTF32_CHAR_T*)utf_arena_alloc(a, m*sizeof(*buf)) : NULL;
+		if (!buf)
+			return (size_t)-1; /* not enough memory */
+		d = buf;
+		(void)UTF_FORM_NAME(_from_token)(&t, &d, m);
+		*q = (const utf8_char_t*)*q + n;
+	}
+	*b = buf;
+	return m;
+}
+
+/*
+ utf8_to_utf32_grow
+ utf8_to_utf32x_grow
+*/
+size_t UTF_FORM_NAME(_grow)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	utf_grow_buf_t *const LIBUTF16_RESTRICT g,
+	size_t n)
+{
+	const size_t len = g->len;
+	while (n) {
+		if (g->len != g->cap) {
+			const utf8_char_t *const s = *q;
+			UTF32_CHAR_T *const o = (UTF32_CHAR_T*)g->buf + g->len;
+			UTF32_CHAR_T *d = o;
+			const size_t sz = g->cap - g->len;
+			const size_t m = UTF_FORM_NAME(_)(q, &d, sz, n, /*determ_size:*/0);
+			g->len += (size_t)(d - o);
+			if (!m)
+				return 0; /* invalid/incomplete utf8 character */
+			if (m <= sz)
+				return g->len - len; /* ok, all 'n' utf8_char_t's were converted */
+			/* output buffer is full, continue from the last converted utf8_char_t */
+			n -= (size_t)(*q - s);
+		}
+		/* each of remaining utf8_char_t's produces at most one utf32_char_t */
+		if (!utf_grow_buf(g, n, sizeof(UTF32_CHAR_T)))
+			return (size_t)-1; /* not enough memory */
+	}
+	return 0; /* n is zero */
+}
+#endif
+
+/*
+ utf8_to_utf32_size_token
+ utf8_to_utf32x_size_token
+ utf8_to_utf32u_size_token
+ utf8_to_utf32ux_size_token
+*/
+size_t UTF_FORM_NAME(_size_token)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	const size_t n,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const size_t sz = UTF_FORM_NAME(_)(q, /*b:*/NULL, /*sz:*/0, n, /*determ_size:*/1);
+	t->src = sz ? *q : NULL;
+	t->n = sz ? n : 0;
+	t->size = sz;
+	t->kind = sz ? UTF_TOKEN_KIND : 0;
+	return sz;
+}
+
+/*
+ utf8_to_utf32_z_size_token
+ utf8_to_utf32x_z_size_token
+ utf8_to_utf32u_z_size_token
+ utf8_to_utf32ux_z_size_token
+*/
+size_t UTF_FORM_NAME(_z_size_token)(
+	const utf8_char_t **const LIBUTF16_RESTRICT q,
+	utf_valid_token_t *const LIBUTF16_RESTRICT t)
+{
+	const utf8_char_t *const s = *q;
+	const size_t sz = UTF_FORM_NAME(_z_)(q, /*b:*/NULL, /*sz:*/0, /*determ_size:*/2);
+	if (!sz) {
+		t->src = NULL;
+		t->n = 0;
+		t->size = 0;
+		t->kind = 0;
+		return 0; /* invalid utf8 string */
+	}
+	t->src = s;
+	t->n = (size_t)(*q - s);
+	t->size = sz;
+	t->kind = UTF_TOKEN_KIND;
+	*q = s; /* (*q) was moved beyond the 0-terminator */
+	return sz;
+}
+
+/*
+ utf8_to_utf32_from_token
+ utf8_to_utf32x_from_token
+ utf8_to_utf32u_from_token
+ utf8_to_utf32ux_from_token
+*/
+size_t UTF_FORM_NAME(_from_token)(
+	const utf_valid_token_t *const LIBUTF16_RESTRICT t,
+	UTF32_CHAR_T **const LIBUTF16_RESTRICT b,
+	const size_t sz)
+{
+	if (t->kind != UTF_TOKEN_KIND)
+		return 0; /* the token is empty or was filled by another conversion */
+	if (t->size > sz)
+		return t->size; /* output buffer is too small */
+#ifdef UTF8_TO_UTF32_AVX2
+	if (libutf16_cpu_features() & UTF_CPU_AVX2) {
+		/* the engine validates the string nearly for free and is faster than the unchecked scalar code */
+		const utf8_char_t *q = (const utf8_char_t*)t->src;
+		return UTF_FORM_NAME(_)(&q, b, t->size, t->n, /*determ_size:*/0);
+	}
+#endif
+	UTF_FORM_NAME(_unsafe)((const utf8_char_t*)t->src, *b, t->n);
+	*b += t->size;
+	return t->size;
+}
+
 /*
  utf8_to_utf32_z_unsafe
  utf8_to_utf32x_z_unsafe
@@ -442,6 +931,10 @@ void UTF_FORM_NAME(_unsafe)(
 				q += 2;
 			}
 		}
+		else if ((size_t)(qe - q) > 8 && q[1] < 0x80) {
+			q = utf8_to_utf32_ascii(q, qe, &b, (const UTF32_CHAR_T*)b + (qe - q));
+			continue; /* (q != qe) */
+		}
 		else
 			q++;
 		UTF32_PUT(b++, (utf32_char_t)a);
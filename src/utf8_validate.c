@@ -0,0 +1,388 @@
+/**********************************************************************************
+* UTF-8 strings validation
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* utf8_validate.c */
+
+#include <stddef.h> /* for size_t */
+
+#ifndef _MSC_VER
+#include <stdint.h> /* for uint16_t/uint32_t */
+#endif
+
+#include <memory.h> /* for memcpy()/memchr() */
+
+#include "libutf16/utf8_validate.h"
+
+#include "utf16_simd.h"
+#include "utf16_swar.h"
+
+#ifdef _MSC_VER
+#pragma warning(disable:5045) /* Compiler will insert Spectre mitigation for memory load if /Qspectre switch specified */
+#endif
+
+#ifdef LIBUTF16_AVX2
+
+/* SIMD engines classify each pair of adjacent utf8_char_t's b1, b2 by three 16-entry lookup tables, indexed
+  by 4-bit nibbles, the pair is invalid if the bitwise AND of looked up values has one of the error bits set
+  (the bit UTF8_TWO_CONTS must be set only for the third and fourth bytes of 3- and 4-byte characters) */
+#define UTF8_TOO_SHORT       0x01 /* 11______ 0_______, 11______ 11______ */
+#define UTF8_TOO_LONG        0x02 /* 0_______ 10______ */
+#define UTF8_OVERLONG_3      0x04 /* 11100000 100_____ */
+#define UTF8_TOO_LARGE       0x08 /* 11110100 1001____, 11110100 101_____, 11110101-11111111 1001____-10111111 */
+#define UTF8_SURROGATE       0x10 /* 11101101 101_____ */
+#define UTF8_OVERLONG_2      0x20 /* 1100000_ 10______ */
+#define UTF8_TOO_LARGE_1000  0x40 /* 11110101-11111111 1000____ */
+#define UTF8_OVERLONG_4      0x40 /* 11110000 1000____ */
+#define UTF8_TWO_CONTS       0x80 /* 10______ 10______ */
+#define UTF8_CARRY           (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+/* indexed by b1 >> 4 */
+static const unsigned char utf8_byte1_high[16] = {
+	UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+	UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+	UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+	UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+	UTF8_TOO_SHORT,
+	UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+	UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+};
+
+/* indexed by b1 & 0xF */
+static const unsigned char utf8_byte1_low[16] = {
+	UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+	UTF8_CARRY | UTF8_OVERLONG_2,
+	UTF8_CARRY,
+	UTF8_CARRY,
+	UTF8_CARRY | UTF8_TOO_LARGE,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+	UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+};
+
+/* indexed by b2 >> 4 */
+static const unsigned char utf8_byte2_high[16] = {
+	UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+	UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+	UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+	UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+};
+
+/* utf8 character is incomplete at the end of a block if one of its last three bytes is greater than
+  the corresponding byte of the last 32 (AVX2) or 64 (AVX-512) bytes of this array */
+static const unsigned char utf8_incomplete_max[64] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+};
+
+/* v shifted by n bytes, with the last n bytes of the previous block shifted in,
+  r - the previous block combined with v by _mm256_permute2x128_si256(prev, v, 0x21) */
+#define UTF8_AVX2_PREV(v, r, n)    _mm256_alignr_epi8(v, r, 16 - (n))
+
+#ifdef LIBUTF16_AVX512
+
+/* the same for AVX-512, r - the previous block combined with v by utf8_avx512_rotate() */
+#define UTF8_AVX512_PREV(v, r, n)  _mm512_alignr_epi8(v, r, 16 - (n))
+
+/* 128-bit lanes: the last lane of p, then the first three lanes of v */
+UTF_TARGET_AVX512
+static inline __m512i utf8_avx512_rotate(const __m512i v, const __m512i p)
+{
+	return _mm512_permutex2var_epi32(v, _mm512_setr_epi32(28, 29, 30, 31, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11), p);
+}
+
+/* look up error bits for the block of 64 utf8_char_t's v, r - v combined with the previous block,
+  returns zero vector if there are no errors, except incomplete character at the end of the block */
+UTF_TARGET_AVX512
+static inline __m512i utf8_avx512_errors(const __m512i v, const __m512i r)
+{
+	const __m512i f = _mm512_set1_epi8(0x0F);
+	const __m512i p1 = UTF8_AVX512_PREV(v, r, 1);
+	const __m512i sc = _mm512_and_si512(
+		_mm512_and_si512(
+			_mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)utf8_byte1_high)),
+				_mm512_and_si512(_mm512_srli_epi16(p1, 4), f)),
+			_mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)utf8_byte1_low)),
+				_mm512_and_si512(p1, f))),
+		_mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i*)utf8_byte2_high)),
+			_mm512_and_si512(_mm512_srli_epi16(v, 4), f)));
+	/* only third and fourth bytes of 3- and 4-byte characters may have UTF8_TWO_CONTS bit set */
+	const __m512i must23 = _mm512_or_si512(
+		_mm512_subs_epu8(UTF8_AVX512_PREV(v, r, 2), _mm512_set1_epi8((char)(0xE0 - 0x80))),
+		_mm512_subs_epu8(UTF8_AVX512_PREV(v, r, 3), _mm512_set1_epi8((char)(0xF0 - 0x80))));
+	return _mm512_xor_si512(_mm512_and_si512(must23, _mm512_set1_epi8((char)0x80)), sc);
+}
+
+/* AVX-512 engine: validate blocks of 64 utf8_char_t's while they remain in the input,
+  stops at the beginning of the block, where invalid utf8 character was found,
+  returns pointer beyond the last validated block */
+UTF_TARGET_AVX512
+static const utf8_char_t *utf8_validate_avx512(const utf8_char_t *s, const utf8_char_t *const se)
+{
+	const __m512i mx = _mm512_loadu_si512(utf8_incomplete_max);
+	__m512i p = _mm512_setzero_si512();   /* previous block */
+	__m512i inc = _mm512_setzero_si512(); /* non-zero if the previous block ends with incomplete character */
+	while ((size_t)(se - s) >= 64) {
+		const __m512i v = _mm512_loadu_si512(s);
+		__m512i err = inc; /* ascii block must not follow incomplete character */
+		if (_mm512_movepi8_mask(v)) {
+			err = utf8_avx512_errors(v, utf8_avx512_rotate(v, p));
+			inc = _mm512_subs_epu8(v, mx);
+		}
+		else
+			inc = _mm512_setzero_si512();
+		if (_mm512_test_epi64_mask(err, err))
+			break;
+		p = v;
+		s += 64;
+	}
+	return s;
+}
+
+#endif /* LIBUTF16_AVX512 */
+
+/* look up error bits for the block of 32 utf8_char_t's v, r - v combined with the previous block,
+  returns zero vector if there are no errors, except incomplete character at the end of the block */
+UTF_TARGET_AVX2
+static inline __m256i utf8_avx2_errors(const __m256i v, const __m256i r)
+{
+	const __m256i f = _mm256_set1_epi8(0x0F);
+	const __m256i p1 = UTF8_AVX2_PREV(v, r, 1);
+	const __m256i sc = _mm256_and_si256(
+		_mm256_and_si256(
+			_mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)utf8_byte1_high)),
+				_mm256_and_si256(_mm256_srli_epi16(p1, 4), f)),
+			_mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)utf8_byte1_low)),
+				_mm256_and_si256(p1, f))),
+		_mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)utf8_byte2_high)),
+			_mm256_and_si256(_mm256_srli_epi16(v, 4), f)));
+	/* only third and fourth bytes of 3- and 4-byte characters may have UTF8_TWO_CONTS bit set */
+	const __m256i must23 = _mm256_or_si256(
+		_mm256_subs_epu8(UTF8_AVX2_PREV(v, r, 2), _mm256_set1_epi8((char)(0xE0 - 0x80))),
+		_mm256_subs_epu8(UTF8_AVX2_PREV(v, r, 3), _mm256_set1_epi8((char)(0xF0 - 0x80))));
+	return _mm256_xor_si256(_mm256_and_si256(must23, _mm256_set1_epi8((char)0x80)), sc);
+}
+
+/* AVX2 engine: validate blocks of 32 utf8_char_t's while they remain in the input,
+  stops at the beginning of the block, where invalid utf8 character was found,
+  returns pointer beyond the last validated block */
+UTF_TARGET_AVX2
+static const utf8_char_t *utf8_validate_avx2(const utf8_char_t *s, const utf8_char_t *const se)
+{
+	const __m256i mx = _mm256_loadu_si256((const __m256i*)(utf8_incomplete_max + 32));
+	__m256i p = _mm256_setzero_si256();   /* previous block */
+	__m256i inc = _mm256_setzero_si256(); /* non-zero if the previous block ends with incomplete character */
+	while ((size_t)(se - s) >= 32) {
+		const __m256i v = _mm256_loadu_si256((const __m256i*)s);
+		__m256i err = inc; /* ascii block must not follow incomplete character */
+		if (_mm256_movemask_epi8(v)) {
+			err = utf8_avx2_errors(v, _mm256_permute2x128_si256(p, v, 0x21));
+			inc = _mm256_subs_epu8(v, mx);
+		}
+		else
+			inc = _mm256_setzero_si256();
+		if (!_mm256_testz_si256(err, err))
+			break;
+		p = v;
+		s += 32;
+	}
+	return s;
+}
+
+/* validate utf8_char_t's from s up to se by the best engine supported by the cpu (does nothing if there is none),
+  (*bad) - set to non-zero if the engine has found invalid utf8 character.
+  Returns pointer to the beginning of the last utf8 character started in the validated blocks: it may be
+  incomplete or invalid, so the scalar code validates it entirely and reports invalid one at exact position */
+static const utf8_char_t *utf8_validate_engine(
+	const utf8_char_t *const s, const utf8_char_t *const se, int *const bad)
+{
+	const utf8_char_t *t = s;
+	unsigned i = 0;
+#ifdef LIBUTF16_AVX512
+	if (libutf16_cpu_features() & UTF_CPU_AVX512) {
+		t = utf8_validate_avx512(s, se);
+		*bad = (size_t)(se - t) >= 64;
+	}
+	else
+#endif
+	if (libutf16_cpu_features() & UTF_CPU_AVX2) {
+		t = utf8_validate_avx2(s, se);
+		*bad = (size_t)(se - t) >= 32;
+	}
+	/* step back over continuation bytes to the starting byte of a multi-byte character */
+	for (; i < 4 && t - i != s; i++) {
+		const unsigned a = t[-1 - (int)i];
+		if (a >= 0xC0)
+			return t - i - 1;
+		if (a < 0x80)
+			break;
+	}
+	return t;
+}
+
+#endif /* LIBUTF16_AVX2 */
+
+/* scalar validation of utf8_char_t's from s up to se,
+  returns pointer to the first invalid utf8 character or se */
+static const utf8_char_t *utf8_validate_scalar(const utf8_char_t *s, const utf8_char_t *const se)
+{
+	while (s != se) {
+		unsigned a = s[0];
+		if (a >= 0x80) {
+			unsigned r;
+			if (a >= 0xE0) {
+				if (a >= 0xF0) {
+					if (a > 0xF4)
+						return s; /* unicode code point must be <= 0x10FFFF */
+					if ((size_t)(se - s) < 4)
+						return s; /* incomplete utf8 character */
+					r = s[1];
+					if (0x80 != (r & 0xC0))
+						return s; /* incomplete utf8 character */
+					a = (a << 6) + r;
+					if (!(0x3C90 <= a && a <= 0x3D8F))
+						return s; /* overlong utf8 character/out of range */
+					if (0x80 != (s[2] & 0xC0) || 0x80 != (s[3] & 0xC0))
+						return s; /* incomplete utf8 character */
+					s += 4;
+				}
+				else {
+					if ((size_t)(se - s) < 3)
+						return s; /* incomplete utf8 character */
+					r = s[1];
+					if (0x80 != (r & 0xC0))
+						return s; /* incomplete utf8 character */
+					a = (a << 6) + r;
+					if (a < 0x38A0 || (0x3BE0 <= a && a <= 0x3BFF))
+						return s; /* overlong utf8 character/surrogate */
+					if (0x80 != (s[2] & 0xC0))
+						return s; /* incomplete utf8 character */
+					s += 3;
+				}
+			}
+			else if (a >= 0xC2) {
+				if ((size_t)(se - s) < 2 || 0x80 != (s[1] & 0xC0))
+					return s; /* incomplete utf8 character */
+				s += 2;
+			}
+			else
+				return s; /* not expecting 10xxxxxx or overlong utf8 character: 1100000x */
+		}
+		else {
+			s++;
+			/* skip a run of ascii characters, 8 utf8_char_t's at a time */
+			while ((size_t)(se - s) >= 8 && !(utf_load64(s) & UTF8_SWAR_NOT_ASCII))
+				s += 8;
+		}
+	}
+	return s;
+}
+
+/* scalar validation of 0-terminated utf8 string,
+  returns pointer to the first invalid utf8 character or to the terminating 0 */
+static const utf8_char_t *utf8_validate_z_scalar(const utf8_char_t *s)
+{
+	for (;; s++) {
+		unsigned a = s[0];
+		if (a >= 0x80) {
+			unsigned r;
+			if (a >= 0xE0) {
+				r = s[1];
+				if (0x80 != (r & 0xC0))
+					break; /* incomplete utf8 character */
+				if (a >= 0xF0) {
+					a = (a << 6) + r;
+					if (!(0x3C90 <= a && a <= 0x3D8F))
+						break; /* overlong utf8 character/out of range */
+					if (0x80 != (s[2] & 0xC0) || 0x80 != (s[3] & 0xC0))
+						break; /* incomplete utf8 character */
+					s += 3;
+				}
+				else {
+					a = (a << 6) + r;
+					if (a < 0x38A0 || (0x3BE0 <= a && a <= 0x3BFF))
+						break; /* overlong utf8 character/surrogate */
+					if (0x80 != (s[2] & 0xC0))
+						break; /* incomplete utf8 character */
+					s += 2;
+				}
+			}
+			else if (a >= 0xC2) {
+				if (0x80 != (s[1] & 0xC0))
+					break; /* incomplete utf8 character */
+				s++;
+			}
+			else
+				break; /* not expecting 10xxxxxx or overlong utf8 character: 1100000x */
+		}
+		else if (!a)
+			break;
+	}
+	return s;
+}
+
+int utf8_validate(
+	const utf8_char_t **const q/*in,out,!=NULL if n>0*/,
+	const size_t n/*0?*/)
+{
+	if (n) {
+		const utf8_char_t *s = *q;
+		const utf8_char_t *const se = s + n;
+#ifdef LIBUTF16_AVX2
+		if (n >= 64) {
+			int bad = 0;
+			s = utf8_validate_engine(s, se, &bad);
+		}
+#endif
+		s = utf8_validate_scalar(s, se);
+		*q = s;
+		return s == se;
+	}
+	return 1; /* n is zero */
+}
+
+#ifdef LIBUTF16_AVX2
+/* size of a window, in which the terminating 0 is searched before validating its part by the engine */
+#define UTF8_Z_WINDOW 4096
+#endif
+
+int utf8_validate_z(
+	const utf8_char_t **const q/*in,out,!=NULL*/)
+{
+	const utf8_char_t *s = *q;
+#ifdef LIBUTF16_AVX2
+	if (libutf16_cpu_features() & (UTF_CPU_AVX2 | UTF_CPU_AVX512)) {
+		const utf8_char_t *z = s;
+		for (;;) {
+			const utf8_char_t *const p = (const utf8_char_t*)memchr(z, 0, UTF8_Z_WINDOW);
+			int bad = 0;
+			z = p ? p : z + UTF8_Z_WINDOW;
+			s = utf8_validate_engine(s, z, &bad);
+			if (p || bad)
+				break; /* 0 was found or the engine has stopped before invalid utf8 character */
+		}
+	}
+#endif
+	s = utf8_validate_z_scalar(s);
+	if (*s) {
+		*q = s; /* (*q) points to invalid utf8 character */
+		return 0;
+	}
+	*q = s + 1; /* points beyond the 0-terminator */
+	return 1;
+}
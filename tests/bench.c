@@ -0,0 +1,125 @@
+/**********************************************************************************
+* Benchmark of conversions of short strings
+* Copyright (C) 2026 Michael M. Builov, https://github.com/mbuilov/libutf16
+* Licensed under Apache License v2.0, see LICENSE.TXT
+**********************************************************************************/
+
+/* bench.c */
+
+/* prints per-call latency (in nanoseconds) of utf8_to_utf16(), utf16_to_utf8() and utf8_to_utf32()
+  for strings of 1..64 source code units, of ascii characters and of mixed ones,
+  output buffers are of the worst-case size, the engine may be limited via LIBUTF16_ENGINE */
+
+#include <stdio.h>
+#include <time.h>
+
+#ifndef _MSC_VER
+#include <stdint.h> /* for uint16_t/uint32_t */
+#endif
+
+#include "libutf16/utf8_to_utf16.h"
+#include "libutf16/utf16_to_utf8.h"
+#include "libutf16/utf8_to_utf32.h"
+#include "libutf16/utf16_engine.h"
+
+#define BENCH_MAX_LEN 64
+#define BENCH_CALLS   100000
+#define BENCH_RUNS    5
+
+static volatile size_t bench_sink;
+
+typedef size_t (*bench_conv_t)(const void *src, size_t n, void *dst, size_t sz);
+
+static size_t bench_utf8_to_utf16(const void *src, size_t n, void *dst, size_t sz)
+{
+	const utf8_char_t *q = (const utf8_char_t*)src;
+	utf16_char_t *b = (utf16_char_t*)dst;
+	return utf8_to_utf16(&q, &b, sz, n);
+}
+
+static size_t bench_utf16_to_utf8(const void *src, size_t n, void *dst, size_t sz)
+{
+	const utf16_char_t *q = (const utf16_char_t*)src;
+	utf8_char_t *b = (utf8_char_t*)dst;
+	return utf16_to_utf8(&q, &b, sz, n);
+}
+
+static size_t bench_utf8_to_utf32(const void *src, size_t n, void *dst, size_t sz)
+{
+	const utf8_char_t *q = (const utf8_char_t*)src;
+	utf32_char_t *b = (utf32_char_t*)dst;
+	return utf8_to_utf32(&q, &b, sz, n);
+}
+
+/* best of BENCH_RUNS runs, in nanoseconds per call */
+static double bench_run(const bench_conv_t conv, const void *src, const size_t n, void *dst, const size_t sz)
+{
+	double best = 0;
+	unsigned r = 0;
+	for (; r < BENCH_RUNS; r++) {
+		const clock_t c = clock();
+		double t;
+		unsigned i = 0;
+		for (; i < BENCH_CALLS; i++)
+			bench_sink += conv(src, n, dst, sz);
+		t = (double)(clock() - c)/CLOCKS_PER_SEC*1e9/BENCH_CALLS;
+		if (!r || t < best)
+			best = t;
+	}
+	return best;
+}
+
+/* fill utf8 string of exactly n bytes: mixed - by 1-, 2- and 3-byte characters, padded by ascii ones */
+static void bench_fill_utf8(utf8_char_t s[], const unsigned n, const int mixed)
+{
+	static const char *const chars[3] = {"a", "\xD0\x96", "\xE4\xB8\x80"};
+	unsigned i = 0, k = 0;
+	while (i < n) {
+		const char *c = chars[mixed ? k++ % 3 : 0];
+		for (; *c && i < n; c++)
+			s[i++] = (utf8_char_t)*c;
+		if (*c) {
+			/* incomplete character: replace its bytes by ascii ones */
+			while (i && s[i - 1] >= 0x80)
+				s[--i] = 'a';
+			while (i < n)
+				s[i++] = 'a';
+		}
+	}
+}
+
+/* fill utf16 string of n utf16_char_t's: mixed - by characters of 1-, 2- and 3-byte utf8 characters */
+static void bench_fill_utf16(utf16_char_t s[], const unsigned n, const int mixed)
+{
+	static const utf16_char_t chars[3] = {'a', 0x416, 0x4E00};
+	unsigned i = 0;
+	for (; i < n; i++)
+		s[i] = chars[mixed ? i % 3 : 0];
+}
+
+int main(void)
+{
+	static utf8_char_t utf8[BENCH_MAX_LEN];
+	static utf16_char_t utf16[BENCH_MAX_LEN];
+	static utf8_char_t dst8[BENCH_MAX_LEN*3];
+	static utf16_char_t dst16[BENCH_MAX_LEN];
+	static utf32_char_t dst32[BENCH_MAX_LEN];
+	static const char *const engines[] = {"scalar", "avx2", "avx512"};
+	const int e = libutf16_engine();
+	unsigned n = 1;
+	printf("engine: %s, nanoseconds per call\n", (0 <= e && e <= 2) ? engines[e] : "?");
+	printf("len   8->16 ascii  8->16 mixed  16->8 ascii  16->8 mixed  8->32 ascii  8->32 mixed\n");
+	for (; n <= BENCH_MAX_LEN; n++) {
+		int mixed = 0;
+		double t[6];
+		for (; mixed < 2; mixed++) {
+			bench_fill_utf8(utf8, n, mixed);
+			bench_fill_utf16(utf16, n, mixed);
+			t[mixed] = bench_run(bench_utf8_to_utf16, utf8, n, dst16, BENCH_MAX_LEN);
+			t[2 + mixed] = bench_run(bench_utf16_to_utf8, utf16, n, dst8, BENCH_MAX_LEN*3);
+			t[4 + mixed] = bench_run(bench_utf8_to_utf32, utf8, n, dst32, BENCH_MAX_LEN);
+		}
+		printf("%3u %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n", n, t[0], t[1], t[2], t[3], t[4], t[5]);
+	}
+	return 0;
+}
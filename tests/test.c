@@ -33,6 +33,11 @@
 #include "libutf16/utf16_to_utf8_one.h"
 #include "libutf16/utf8_cstd.h"
 #include "libutf16/utf16_swap.h"
+#include "libutf16/utf16_engine.h"
+#include "libutf16/utf8_validate.h"
+#include "libutf16/utf16_validate.h"
+#include "libutf16/utf32_validate.h"
+#include "libutf16/utf16_arena.h"
 
 static unsigned long long test_number = 0;
 
@@ -151,6 +156,43 @@ static unsigned long long test_number = 0;
 static int z(void)  {return 0;}
 static int nz(void) {return 1;}
 
+/* sample characters of all utf8 lengths: 1-, 2-, 3- and 4-byte ones */
+static const struct {
+	const char *s;
+	unsigned n;
+	utf16_char_t c[2];
+	utf32_char_t u;
+} mixed_sample[4] = {
+	{"a", 1, {'a', 0}, 'a'}, {"\xD0\x96", 2, {0x416, 0}, 0x416},
+	{"\xE4\xB8\x80", 3, {0x4E00, 0}, 0x4E00}, {"\xF0\x90\x90\xB7", 4, {0xD801, 0xDC37}, 0x10437}
+};
+
+/* build a string of k characters: runs of ascii characters alternate with runs of characters
+  of mixed lengths, where characters of the same length go in groups (if k % 4 == 1 - the string is pure ascii),
+  store the string in utf8, utf16 and utf32 (if not NULL) forms,
+  returns the number of utf8_char_t's, (*l) - the number of utf16_char_t's */
+static unsigned build_mixed(const unsigned k, utf8_char_t utf8[], utf16_char_t utf16[], utf32_char_t utf32[],
+	unsigned *const l)
+{
+	unsigned i = 0, n = 0;
+	*l = 0;
+	for (; i < k; i++) {
+		const unsigned f = i/(k/8 + 1) % 2 ? (i/(k % 11 + 1) + k) % 4 * (k % 4 != 1) : 0;
+		memcpy(utf8 + n, mixed_sample[f].s, mixed_sample[f].n);
+		n += mixed_sample[f].n;
+		if (utf16) {
+			utf16[(*l)++] = mixed_sample[f].c[0];
+			if (mixed_sample[f].c[1])
+				utf16[(*l)++] = mixed_sample[f].c[1];
+		}
+		else
+			*l += 1 + !!mixed_sample[f].c[1];
+		if (utf32)
+			utf32[i] = mixed_sample[f].u;
+	}
+	return n;
+}
+
 static int test_utf16_to_utf8(
 	const unsigned initial_step,
 	const utf16_char_t *const utf16_le_be[2],
@@ -287,6 +329,1440 @@ static int test_utf8_to_utf16(
 	return 0;
 }
 
+/* lead byte 0xF4 encodes code points up to U+10FFFF, and a 4-byte utf8 character
+  which does not fit into the output buffer is counted again without reading past the end of input */
+static int test_utf8_to_utf16_edge(void)
+{
+	/* the byte after the 4-byte character is not part of the input, it must not be read */
+	static const utf8_char_t s4[] = {'a', 0xF0, 0x90, 0x80, 0x80, 0xFF};
+	static const utf8_char_t f4[] = {0xF4, 0x80, 0x81, 0x80, 0xF4, 0x8F, 0xBF, 0xBF, 0};
+	utf16_char_t utf16[5];
+	{
+		const utf8_char_t *q = s4;
+		utf16_char_t *b = utf16;
+		TEST(3 == utf8_to_utf16(&q, &b, 2, 5));
+		TEST(q == s4 + 1 && b == utf16 + 1 && utf16[0] == 'a');
+	}
+	{
+		const utf8_char_t *q = s4;
+		utf16_char_t *b = utf16;
+		TEST(2 < utf8_to_utf16_partial(&q, &b, 2, 5));
+		TEST(q == s4 + 1 && b == utf16 + 1);
+	}
+	{
+		const utf8_char_t *q = s4;
+		TEST(3 == utf8_to_utf16_size(&q, 5));
+	}
+	{
+		const utf8_char_t *q = f4;
+		utf16_char_t *b = utf16;
+		TEST(5 == utf8_to_utf16_z(&q, &b, 5));
+		TEST(utf16[0] == 0xDBC0 && utf16[1] == 0xDC40 && utf16[2] == 0xDBFF && utf16[3] == 0xDFFF && !utf16[4]);
+	}
+	{
+		const utf8_char_t *q = f4;
+		TEST(5 == utf8_to_utf16_z_size(&q));
+	}
+	{
+		utf32_char_t w;
+		TEST(f4 + 8 == utf8_to_utf32_one_z(&w, f4 + 4));
+		TEST(w == 0x10FFFF);
+	}
+	return 0;
+}
+
+/* long utf8 strings are converted by blocks, check that invalid utf8 characters
+  are still found at exact positions and 4-byte utf8 characters are converted correctly */
+static int test_utf8_long(void)
+{
+	static const struct {
+		const char *s;
+		unsigned n;
+	} bad[] = {
+		{"\x80", 1}, {"\xBF", 1}, {"\xC0\x80", 2}, {"\xC1\xBF", 2}, {"\xC2", 1}, {"\xDF\xC0", 2},
+		{"\xE0\x80\x80", 3}, {"\xE0\x9F\xBF", 3}, {"\xED\xA0\x80", 3}, {"\xED\xBF\xBF", 3}, {"\xEF\xBF", 2},
+		{"\xF0\x80\x80\x80", 4}, {"\xF0\x8F\xBF\xBF", 4}, {"\xF0\x90\x80", 3}, {"\xF4\x90\x80\x80", 4},
+		{"\xF5\x80\x80\x80", 4}, {"\xF8\x88\x80\x80\x80", 5}, {"\xFF", 1}
+	};
+	utf8_char_t utf8[200];
+	utf16_char_t utf16[200];
+	utf32_char_t utf32[200];
+	unsigned i = 0;
+	for (; i < sizeof(bad)/sizeof(bad[0]); i++) {
+		unsigned p = 0;
+		for (; p + bad[i].n < sizeof(utf8); p++) {
+			memset(utf8, 'a', sizeof(utf8) - 1);
+			utf8[sizeof(utf8) - 1] = 0;
+			memcpy(utf8 + p, bad[i].s, bad[i].n);
+			{
+				const utf8_char_t *q = utf8;
+				utf16_char_t *b = utf16;
+				TEST(!utf8_to_utf16(&q, &b, sizeof(utf16)/sizeof(utf16[0]), sizeof(utf8)));
+				TEST(q == utf8 + p);
+				TEST(b == utf16 + p);
+			}
+			{
+				const utf8_char_t *q = utf8;
+				utf16_char_t *b = utf16;
+				TEST(!utf8_to_utf16_z(&q, &b, sizeof(utf16)/sizeof(utf16[0])));
+				TEST(q == utf8 + p);
+				TEST(b == utf16 + p);
+			}
+			{
+				const utf8_char_t *q = utf8;
+				utf32_char_t *b = utf32;
+				TEST(!utf8_to_utf32(&q, &b, sizeof(utf32)/sizeof(utf32[0]), sizeof(utf8)));
+				TEST(q == utf8 + p);
+				TEST(b == utf32 + p);
+			}
+			{
+				const utf8_char_t *q = utf8;
+				utf32_char_t *b = utf32;
+				TEST(!utf8_to_utf32_z(&q, &b, sizeof(utf32)/sizeof(utf32[0])));
+				TEST(q == utf8 + p);
+				TEST(b == utf32 + p);
+			}
+			{
+				/* size-only pass must find invalid utf8 characters as well */
+				const utf8_char_t *q = utf8;
+				TEST(!utf8_to_utf16_size(&q, sizeof(utf8)));
+				TEST(q == utf8 + p);
+				q = utf8;
+				TEST(!utf8_to_utf16_z_size(&q));
+				TEST(q == utf8 + p);
+				q = utf8;
+				TEST(!utf8_to_utf32_size(&q, sizeof(utf8)));
+				TEST(q == utf8 + p);
+				q = utf8;
+				TEST(!utf8_to_utf32_z_size(&q));
+				TEST(q == utf8 + p);
+			}
+		}
+	}
+	for (i = 0; i + 8 < sizeof(utf8) - 1; i++) {
+		memset(utf8, 'a', sizeof(utf8) - 1);
+		utf8[sizeof(utf8) - 1] = 0;
+		memcpy(utf8 + i, "\xF4\x8F\xBF\xBF\xF4\x80\x81\x80", 8);
+		{
+			const utf8_char_t *q = utf8;
+			utf16_char_t *b = utf16;
+			TEST(sizeof(utf8) - 4 == utf8_to_utf16(&q, &b, sizeof(utf16)/sizeof(utf16[0]), sizeof(utf8)));
+			TEST(utf16[i] == 0xDBFF && utf16[i + 1] == 0xDFFF && utf16[i + 2] == 0xDBC0 && utf16[i + 3] == 0xDC40);
+			TEST(utf16[i + 4] == 'a' && !utf16[sizeof(utf8) - 5]);
+		}
+		{
+			const utf8_char_t *q = utf8;
+			utf16_char_t *b = utf16;
+			TEST(sizeof(utf8) - 4 == utf8_to_utf16_z(&q, &b, sizeof(utf16)/sizeof(utf16[0])));
+			TEST(utf16[i] == 0xDBFF && utf16[i + 1] == 0xDFFF && utf16[i + 2] == 0xDBC0 && utf16[i + 3] == 0xDC40);
+			TEST(utf16[i + 4] == 'a' && !utf16[sizeof(utf8) - 5]);
+		}
+		{
+			const utf8_char_t *q = utf8;
+			TEST(sizeof(utf8) - 4 == utf8_to_utf16_z_size(&q));
+			q = utf8;
+			TEST(sizeof(utf8) - 4 == utf8_to_utf16_size(&q, sizeof(utf8)));
+		}
+		{
+			const utf8_char_t *q = utf8;
+			utf32_char_t *b = utf32;
+			TEST(sizeof(utf8) - 6 == utf8_to_utf32(&q, &b, sizeof(utf32)/sizeof(utf32[0]), sizeof(utf8)));
+			TEST(utf32[i] == 0x10FFFF && utf32[i + 1] == 0x100040);
+			TEST(utf32[i + 2] == 'a' && !utf32[sizeof(utf8) - 7]);
+		}
+		{
+			const utf8_char_t *q = utf8;
+			utf32_char_t *b = utf32;
+			TEST(sizeof(utf8) - 6 == utf8_to_utf32_z(&q, &b, sizeof(utf32)/sizeof(utf32[0])));
+			TEST(utf32[i] == 0x10FFFF && utf32[i + 1] == 0x100040);
+			TEST(utf32[i + 2] == 'a' && !utf32[sizeof(utf8) - 7]);
+		}
+		{
+			const utf8_char_t *q = utf8;
+			TEST(sizeof(utf8) - 6 == utf8_to_utf32_z_size(&q));
+			q = utf8;
+			TEST(sizeof(utf8) - 6 == utf8_to_utf32_size(&q, sizeof(utf8)));
+		}
+	}
+	return 0;
+}
+
+static int test_ascii_runs(void)
+{
+	utf8_char_t utf8[50], utf8_buf[51];
+	utf16_char_t utf16[50], utf16_buf[51];
+	utf32_char_t utf32[50], utf32_buf[51];
+	unsigned k = 1;
+	for (; k < 40; k++) {
+		unsigned p = 0;
+		for (; p <= k; p++) {
+			/* run of k ascii characters, the character at position p (if p < k) is out of BMP,
+			  strings are converted to buffers of exact size, the next character must not be touched */
+			unsigned i = 0, n8 = 0, n16 = 0;
+			for (; i < k; i++) {
+				if (i == p) {
+					memcpy(utf8 + n8, "\xF0\x90\x90\xB7", 4);
+					n8 += 4;
+					utf16[n16++] = 0xD801;
+					utf16[n16++] = 0xDC37;
+					utf32[i] = 0x10437;
+				}
+				else {
+					utf8[n8++] = (utf8_char_t)('a' + i % 26);
+					utf16[n16++] = (utf16_char_t)('a' + i % 26);
+					utf32[i] = (utf32_char_t)('a' + i % 26);
+				}
+			}
+			{
+				const utf8_char_t *q = utf8;
+				utf16_char_t *b = utf16_buf;
+				utf16_buf[n16] = 0xFFFF;
+				TEST(n16 == utf8_to_utf16(&q, &b, n16, n8));
+				TEST(q == utf8 + n8 && b == utf16_buf + n16);
+				TEST(!memcmp(utf16_buf, utf16, n16*sizeof(utf16[0])) && utf16_buf[n16] == 0xFFFF);
+			}
+			{
+				const utf8_char_t *q = utf8;
+				utf32_char_t *b = utf32_buf;
+				utf32_buf[k] = 0xFFFFFFFF;
+				TEST(k == utf8_to_utf32(&q, &b, k, n8));
+				TEST(q == utf8 + n8 && b == utf32_buf + k);
+				TEST(!memcmp(utf32_buf, utf32, k*sizeof(utf32[0])) && utf32_buf[k] == 0xFFFFFFFF);
+			}
+			{
+				const utf16_char_t *q = utf16;
+				utf8_char_t *b = utf8_buf;
+				utf8_buf[n8] = 0xFF;
+				TEST(n8 == utf16_to_utf8(&q, &b, n8, n16));
+				TEST(q == utf16 + n16 && b == utf8_buf + n8);
+				TEST(!memcmp(utf8_buf, utf8, n8) && utf8_buf[n8] == 0xFF);
+			}
+			{
+				const utf32_char_t *q = utf32;
+				utf8_char_t *b = utf8_buf;
+				utf8_buf[n8] = 0xFF;
+				TEST(n8 == utf32_to_utf8(&q, &b, n8, k));
+				TEST(q == utf32 + k && b == utf8_buf + n8);
+				TEST(!memcmp(utf8_buf, utf8, n8) && utf8_buf[n8] == 0xFF);
+			}
+			{
+				const utf16_char_t *q = utf16;
+				utf32_char_t *b = utf32_buf;
+				utf32_buf[k] = 0xFFFFFFFF;
+				TEST(k == utf16_to_utf32(&q, &b, k, n16));
+				TEST(q == utf16 + n16 && b == utf32_buf + k);
+				TEST(!memcmp(utf32_buf, utf32, k*sizeof(utf32[0])) && utf32_buf[k] == 0xFFFFFFFF);
+			}
+			{
+				const utf32_char_t *q = utf32;
+				utf16_char_t *b = utf16_buf;
+				utf16_buf[n16] = 0xFFFF;
+				TEST(n16 == utf32_to_utf16(&q, &b, n16, k));
+				TEST(q == utf32 + k && b == utf16_buf + n16);
+				TEST(!memcmp(utf16_buf, utf16, n16*sizeof(utf16[0])) && utf16_buf[n16] == 0xFFFF);
+			}
+		}
+	}
+	return 0;
+}
+
+static int test_unaligned(void)
+{
+	utf8_char_t utf8[1000], utf8_buf[1000];
+	utf16_char_t utf16[500];
+	utf32_char_t utf32[500];
+	unsigned char buf[4*500 + 3];
+	unsigned l16, k = 1;
+	const unsigned l32 = 300;
+	const unsigned n = build_mixed(l32, utf8, utf16, utf32, &l16);
+	TEST(l16 > l32);
+	/* unaligned variants must give the same results at any offset */
+	for (; k < 4; k++) {
+		{
+			const utf8_char_t *q = utf8;
+			utf16_char_unaligned_t *b = (utf16_char_unaligned_t*)(buf + k);
+			TEST(l16 == utf8_to_utf16u(&q, &b, l16, n));
+			TEST(q == utf8 + n && (unsigned char*)b == buf + k + l16*sizeof(utf16[0]));
+			TEST(!memcmp(buf + k, utf16, l16*sizeof(utf16[0])));
+		}
+		{
+			const utf16_char_unaligned_t *q = (const utf16_char_unaligned_t*)(buf + k);
+			utf8_char_t *b = utf8_buf;
+			TEST(n == utf16u_to_utf8(&q, &b, n, l16));
+			TEST(b == utf8_buf + n && !memcmp(utf8_buf, utf8, n));
+		}
+		{
+			const utf8_char_t *q = utf8;
+			utf32_char_unaligned_t *b = (utf32_char_unaligned_t*)(buf + k);
+			TEST(l32 == utf8_to_utf32u(&q, &b, l32, n));
+			TEST(q == utf8 + n && (unsigned char*)b == buf + k + l32*sizeof(utf32[0]));
+			TEST(!memcmp(buf + k, utf32, l32*sizeof(utf32[0])));
+		}
+		{
+			const utf32_char_unaligned_t *q = (const utf32_char_unaligned_t*)(buf + k);
+			utf8_char_t *b = utf8_buf;
+			TEST(n == utf32u_to_utf8(&q, &b, n, l32));
+			TEST(b == utf8_buf + n && !memcmp(utf8_buf, utf8, n));
+		}
+	}
+	return 0;
+}
+
+/* 0-terminated strings ending near the end of a memory page */
+static int test_page_end(void)
+{
+	static unsigned char page_buf[3*4096];
+	unsigned char *const end = page_buf + 2*4096 - ((size_t)page_buf & 4095); /* page boundary */
+	utf32_char_t utf32[40];
+	utf16_char_t utf16[80];
+	utf8_char_t utf8[160], utf8_buf[160];
+	utf16_char_t utf16_buf[80];
+	utf32_char_t utf32_buf[41];
+	unsigned n16, i;
+	const unsigned n8 = build_mixed(40, utf8, utf16, utf32, &n16);
+	TEST(n16 > 40 && n8 > n16);
+	memset(page_buf, 0x41, sizeof(page_buf)); /* non-zero after the terminating 0 */
+	for (i = 0; i < 2*32; i++) {
+		/* terminating 0 is at (i - 32) units from the page boundary */
+		{
+			utf16_char_t *const z = (utf16_char_t*)end + i - 32;
+			const utf16_char_t *q = z - n16;
+			utf8_char_t *b = utf8_buf;
+			utf32_char_t *b32 = utf32_buf;
+			memcpy(z - n16, utf16, n16*sizeof(utf16[0]));
+			*z = 0;
+			TEST(n8 + 1 == utf16_to_utf8_z(&q, &b, sizeof(utf8_buf)));
+			TEST(q == z + 1 && !memcmp(utf8_buf, utf8, n8) && !utf8_buf[n8]);
+			q = z - n16;
+			TEST(40 + 1 == utf16_to_utf32_z(&q, &b32, sizeof(utf32_buf)/sizeof(utf32_buf[0])));
+			TEST(q == z + 1 && !memcmp(utf32_buf, utf32, sizeof(utf32)) && !utf32_buf[40]);
+			memset(z - n16, 0x41, (n16 + 1)*sizeof(utf16[0]));
+		}
+		{
+			utf32_char_t *const z = (utf32_char_t*)end + i - 32;
+			const utf32_char_t *q = z - 40;
+			utf8_char_t *b = utf8_buf;
+			utf16_char_t *b16 = utf16_buf;
+			memcpy(z - 40, utf32, sizeof(utf32));
+			*z = 0;
+			TEST(n8 + 1 == utf32_to_utf8_z(&q, &b, sizeof(utf8_buf)));
+			TEST(q == z + 1 && !memcmp(utf8_buf, utf8, n8) && !utf8_buf[n8]);
+			q = z - 40;
+			TEST(n16 + 1 == utf32_to_utf16_z(&q, &b16, sizeof(utf16_buf)/sizeof(utf16_buf[0])));
+			TEST(q == z + 1 && !memcmp(utf16_buf, utf16, n16*sizeof(utf16[0])) && !utf16_buf[n16]);
+			memset(z - 40, 0x41, sizeof(utf32) + sizeof(utf32[0]));
+		}
+	}
+	return 0;
+}
+
+static int test_short_page_end(void)
+{
+	static unsigned char page_buf[3*4096];
+	unsigned char *const end = page_buf + 2*4096 - ((size_t)page_buf & 4095); /* page boundary */
+	utf32_char_t utf32[40], utf32_buf[41];
+	utf16_char_t utf16[80], utf16_buf[81];
+	utf8_char_t utf8[160], utf8_buf[161];
+	unsigned k = 1;
+	for (; k < 40; k++) {
+		unsigned mixed = 0;
+		for (; mixed < 2; mixed++) {
+			/* string of k characters ends at the page boundary, or at (o) units before it */
+			unsigned n8, n16, i = 0, o = 0;
+			if (mixed)
+				n8 = build_mixed(k, utf8, utf16, utf32, &n16);
+			else {
+				for (; i < k; i++) {
+					utf8[i] = 'a';
+					utf16[i] = 'a';
+					utf32[i] = 'a';
+				}
+				n8 = n16 = k;
+			}
+			for (; o < 3; o++) {
+				{
+					utf8_char_t *const s = end - o - n8;
+					const utf8_char_t *q = s;
+					utf16_char_t *b16 = utf16_buf;
+					utf32_char_t *b32 = utf32_buf;
+					memcpy(s, utf8, n8);
+					utf16_buf[n16] = 0xFFFF;
+					TEST(n16 == utf8_to_utf16(&q, &b16, n16, n8));
+					TEST(q == s + n8 && b16 == utf16_buf + n16);
+					TEST(!memcmp(utf16_buf, utf16, n16*sizeof(utf16[0])) && utf16_buf[n16] == 0xFFFF);
+					q = s;
+					utf32_buf[k] = 0xFFFFFFFF;
+					TEST(k == utf8_to_utf32(&q, &b32, k, n8));
+					TEST(q == s + n8 && b32 == utf32_buf + k);
+					TEST(!memcmp(utf32_buf, utf32, k*sizeof(utf32[0])) && utf32_buf[k] == 0xFFFFFFFF);
+					if (utf32[k - 1] >= 0x80) {
+						/* the last character is incomplete */
+						const unsigned m = n8 - (utf32[k - 1] >= 0x10000 ? 4u : utf32[k - 1] >= 0x800 ? 3u : 2u);
+						q = s;
+						b16 = utf16_buf;
+						TEST(!utf8_to_utf16(&q, &b16, n16, n8 - 1));
+						TEST(q == s + m && !memcmp(utf16_buf, utf16, (size_t)(b16 - utf16_buf)*sizeof(utf16[0])));
+						q = s;
+						b32 = utf32_buf;
+						TEST(!utf8_to_utf32(&q, &b32, k, n8 - 1));
+						TEST(q == s + m && b32 == utf32_buf + k - 1);
+					}
+				}
+				{
+					utf16_char_t *const s = (utf16_char_t*)end - o - n16;
+					const utf16_char_t *q = s;
+					utf8_char_t *b = utf8_buf;
+					memcpy(s, utf16, n16*sizeof(utf16[0]));
+					utf8_buf[n8] = 0xFF;
+					TEST(n8 == utf16_to_utf8(&q, &b, n8, n16));
+					TEST(q == s + n16 && b == utf8_buf + n8);
+					TEST(!memcmp(utf8_buf, utf8, n8) && utf8_buf[n8] == 0xFF);
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+/* check utf16{,u}{,x}_validate{,_z} of n utf16_char_t's at s, e - expected invalid utf16_char_t or NULL,
+  _z functions are checked if s[n] == 0 */
+static int test_utf16_validate_forms(const utf16_char_t s[], const unsigned n, const utf16_char_t *const e)
+{
+	utf16_char_t x[301];
+	unsigned char u[sizeof(x) + 1];
+	const unsigned k = (unsigned)(e ? e - s : n);
+	const int z = !s[n], ok = !e;
+	unsigned i = 0;
+	for (; i <= n; i++)
+		x[i] = utf16_swap_bytes(s[i]);
+	{
+		const utf16_char_t *q = s;
+		TEST(ok == utf16_validate(&q, n));
+		TEST(q == s + k);
+		q = x;
+		TEST(ok == utf16x_validate(&q, n));
+		TEST(q == x + k);
+		if (z) {
+			q = s;
+			TEST(ok == utf16_validate_z(&q));
+			TEST(q == s + k + ok);
+			q = x;
+			TEST(ok == utf16x_validate_z(&q));
+			TEST(q == x + k + ok);
+		}
+	}
+	for (i = 0; i < 2; i++) {
+		const utf16_char_unaligned_t *const b = (const utf16_char_unaligned_t*)(u + 1);
+		const utf16_char_unaligned_t *q = b;
+		memcpy(u + 1, i ? x : s, (n + 1)*sizeof(x[0]));
+		TEST(ok == (i ? utf16ux_validate(&q, n) : utf16u_validate(&q, n)));
+		TEST(q == b + k);
+		if (z) {
+			q = b;
+			TEST(ok == (i ? utf16ux_validate_z(&q) : utf16u_validate_z(&q)));
+			TEST(q == b + k + ok);
+		}
+	}
+	return 0;
+}
+
+/* check utf32{,u}{,x}_validate{,_z} of n utf32_char_t's at s, e - expected invalid utf32_char_t or NULL,
+  _z functions are checked if s[n] == 0 */
+static int test_utf32_validate_forms(const utf32_char_t s[], const unsigned n, const utf32_char_t *const e)
+{
+	utf32_char_t x[301];
+	unsigned char u[sizeof(x) + 1];
+	const unsigned k = (unsigned)(e ? e - s : n);
+	const int z = !s[n], ok = !e;
+	unsigned i = 0;
+	for (; i <= n; i++)
+		x[i] = utf32_swap_bytes(s[i]);
+	{
+		const utf32_char_t *q = s;
+		TEST(ok == utf32_validate(&q, n));
+		TEST(q == s + k);
+		q = x;
+		TEST(ok == utf32x_validate(&q, n));
+		TEST(q == x + k);
+		if (z) {
+			q = s;
+			TEST(ok == utf32_validate_z(&q));
+			TEST(q == s + k + ok);
+			q = x;
+			TEST(ok == utf32x_validate_z(&q));
+			TEST(q == x + k + ok);
+		}
+	}
+	for (i = 0; i < 2; i++) {
+		const utf32_char_unaligned_t *const b = (const utf32_char_unaligned_t*)(u + 1);
+		const utf32_char_unaligned_t *q = b;
+		memcpy(u + 1, i ? x : s, (n + 1)*sizeof(x[0]));
+		TEST(ok == (i ? utf32ux_validate(&q, n) : utf32u_validate(&q, n)));
+		TEST(q == b + k);
+		if (z) {
+			q = b;
+			TEST(ok == (i ? utf32ux_validate_z(&q) : utf32u_validate_z(&q)));
+			TEST(q == b + k + ok);
+		}
+	}
+	return 0;
+}
+
+static int test_validate(void)
+{
+	static const char pattern8[] = "ab\xD0\x96\xE4\xB8\xAD\xF0\x9F\x98\x80"; /* characters at 0, 1, 2, 4, 7 */
+	static const utf16_char_t pattern16[5] = {0x61, 0x416, 0xD83D, 0xDE00, 0x4E2D};
+	static const utf32_char_t pattern32[5] = {0x61, 0x416, 0x1F600, 0x4E2D, 0x10FFFF};
+	static const struct {
+		const char *s;
+		unsigned n;
+	} bad[] = {
+		{"\x80", 1}, {"\xC1\xBF", 2}, {"\xC2", 1}, {"\xE0\x9F\xBF", 3}, {"\xED\xA0\x80", 3}, {"\xEF\xBF", 2},
+		{"\xF0\x8F\xBF\xBF", 4}, {"\xF0\x90\x80", 3}, {"\xF4\x90\x80\x80", 4}, {"\xF5\x80\x80\x80", 4}, {"\xFF", 1}
+	};
+	static const utf32_char_t bad32[4] = {0xD800, 0xDFFF, 0x110000, 0xFFFFFFFF};
+	utf8_char_t utf8[11*54 + 1];
+	utf16_char_t utf16[301];
+	utf32_char_t utf32[301];
+	const unsigned n8 = sizeof(utf8) - 1;
+	unsigned i = 0, j;
+	for (; i < n8; i++)
+		utf8[i] = (utf8_char_t)pattern8[i % 11];
+	utf8[n8] = 0;
+	/* any prefix of valid utf8 string is valid if it ends at the character boundary */
+	for (i = 0; i <= n8; i++) {
+		const unsigned o = i % 11;
+		const unsigned b = i - o + (o >= 7 ? 7 : o >= 4 ? 4 : o >= 2 ? 2 : o);
+		const utf8_char_t *q = utf8;
+		TEST((b == i) == utf8_validate(&q, i));
+		TEST(q == utf8 + b);
+	}
+	{
+		const utf8_char_t *q = utf8;
+		TEST(utf8_validate_z(&q));
+		TEST(q == utf8 + n8 + 1);
+	}
+	for (i = 0; i < sizeof(bad)/sizeof(bad[0]); i++) {
+		for (j = 0; j + 11 < n8; j += 11) {
+			unsigned p = 0;
+			for (; p < 11; p += 1 + (p >= 2) + (p >= 4) + (p >= 7)) {
+				const utf8_char_t *q = utf8 + j + p;
+				memcpy(utf8 + j + p, bad[i].s, bad[i].n);
+				memset(utf8 + j + p + bad[i].n, 'a', 4);
+				TEST(!utf8_validate_z(&q) && q == utf8 + j + p);
+				q = utf8;
+				TEST(!utf8_validate(&q, n8));
+				TEST(q == utf8 + j + p);
+				q = utf8;
+				TEST(!utf8_validate_z(&q));
+				TEST(q == utf8 + j + p);
+				memcpy(utf8 + j, pattern8, 11);
+				memcpy(utf8 + j + 11, pattern8, 11);
+			}
+		}
+	}
+	for (i = 0; i < 300; i++) {
+		utf16[i] = pattern16[i % 5];
+		utf32[i] = pattern32[i % 5];
+	}
+	utf16[300] = 0;
+	utf32[300] = 0;
+	TEST(!test_utf16_validate_forms(utf16, 300, NULL));
+	TEST(!test_utf32_validate_forms(utf32, 300, NULL));
+	for (i = 0; i < 300; i++) {
+		const unsigned o = i % 5;
+		/* the string is cut after a high surrogate */
+		TEST(!test_utf16_validate_forms(utf16, i, 3 == o ? utf16 + i - 1 : NULL));
+		if (3 != o) {
+			/* lone low surrogate */
+			utf16[i] = 0xDC00;
+			TEST(!test_utf16_validate_forms(utf16, 300, utf16 + i));
+			/* high surrogate followed by non-low one */
+			utf16[i] = 0xDBFF;
+			utf16[i + 1] = 0x61;
+			TEST(!test_utf16_validate_forms(utf16, 300, utf16 + i));
+			utf16[i] = pattern16[o];
+			utf16[i + 1] = i + 1 < 300 ? pattern16[(i + 1) % 5] : 0;
+		}
+		for (j = 0; j < sizeof(bad32)/sizeof(bad32[0]); j++) {
+			utf32[i] = bad32[j];
+			TEST(!test_utf32_validate_forms(utf32, 300, utf32 + i));
+		}
+		utf32[i] = pattern32[o];
+	}
+	return 0;
+}
+
+static int test_utf16_to_utf8_long(void)
+{
+	static const struct {
+		utf16_char_t s[2];
+		unsigned n;
+	} bad[] = {
+		{{0xD800, 'a'}, 2}, {{0xDBFF, 0x430}, 2}, {{0xDBFF, 0xD800}, 2},
+		{{0xDC00, 0}, 1}, {{0xDFFF, 0}, 1}, {{0xDC00, 0xD800}, 2}
+	};
+	static const utf16_char_t fill[3] = {'a', 0x430, 0x4E00};
+	utf16_char_t utf16[200];
+	utf8_char_t utf8[600];
+	unsigned i = 0;
+	for (; i < sizeof(bad)/sizeof(bad[0]); i++) {
+		unsigned p = 0, l = 0;
+		for (; p + bad[i].n < sizeof(utf16)/sizeof(utf16[0]); l += 1 + p % 3, p++) {
+			unsigned j = 0;
+			for (; j < sizeof(utf16)/sizeof(utf16[0]) - 1; j++)
+				utf16[j] = fill[j % 3];
+			utf16[j] = 0;
+			memcpy(utf16 + p, bad[i].s, bad[i].n*sizeof(utf16[0]));
+			{
+				const utf16_char_t *q = utf16;
+				utf8_char_t *b = utf8;
+				TEST(!utf16_to_utf8(&q, &b, sizeof(utf8), sizeof(utf16)/sizeof(utf16[0])));
+				TEST(q == utf16 + p);
+				TEST(b == utf8 + l);
+			}
+			{
+				const utf16_char_t *q = utf16;
+				utf8_char_t *b = utf8;
+				TEST(!utf16_to_utf8_z(&q, &b, sizeof(utf8)));
+				TEST(q == utf16 + p);
+				TEST(b == utf8 + l);
+			}
+			{
+				/* size-only pass must find invalid utf16 characters as well */
+				const utf16_char_t *q = utf16;
+				TEST(!utf16_to_utf8_size(&q, sizeof(utf16)/sizeof(utf16[0])));
+				TEST(q == utf16 + p);
+				q = utf16;
+				TEST(!utf16_to_utf8_z_size(&q));
+				TEST(q == utf16 + p);
+			}
+		}
+	}
+	for (i = 0; i + 5 < sizeof(utf16)/sizeof(utf16[0]); i++) {
+		unsigned j = 0;
+		for (; j < sizeof(utf16)/sizeof(utf16[0]) - 1; j++)
+			utf16[j] = 'a';
+		utf16[j] = 0;
+		utf16[i] = 0xDBFF;
+		utf16[i + 1] = 0xDFFF;
+		utf16[i + 2] = 0xD800;
+		utf16[i + 3] = 0xDC00;
+		{
+			const utf16_char_t *q = utf16;
+			utf8_char_t *b = utf8;
+			TEST(sizeof(utf16)/sizeof(utf16[0]) + 4 == utf16_to_utf8(&q, &b, sizeof(utf8), sizeof(utf16)/sizeof(utf16[0])));
+			TEST(!memcmp(utf8 + i, "\xF4\x8F\xBF\xBF\xF0\x90\x80\x80" "a", 9));
+			TEST(!utf8[sizeof(utf16)/sizeof(utf16[0]) + 3]);
+		}
+		{
+			const utf16_char_t *q = utf16;
+			utf8_char_t *b = utf8;
+			TEST(sizeof(utf16)/sizeof(utf16[0]) + 4 == utf16_to_utf8_z(&q, &b, sizeof(utf8)));
+			TEST(!memcmp(utf8 + i, "\xF4\x8F\xBF\xBF\xF0\x90\x80\x80" "a", 9));
+			TEST(!utf8[sizeof(utf16)/sizeof(utf16[0]) + 3]);
+		}
+		{
+			const utf16_char_t *q = utf16;
+			TEST(sizeof(utf16)/sizeof(utf16[0]) + 4 == utf16_to_utf8_z_size(&q));
+			q = utf16;
+			TEST(sizeof(utf16)/sizeof(utf16[0]) + 3 == utf16_to_utf8_size(&q, sizeof(utf16)/sizeof(utf16[0]) - 1));
+		}
+	}
+	for (i = 1; i < 40; i++) {
+		/* high surrogate at the end of the input, output buffers of the worst-case size and one less */
+		unsigned j = 0, l = 0;
+		for (; j < i - 1; l += 1 + j % 3, j++)
+			utf16[j] = fill[j % 3];
+		utf16[j] = 0xD800;
+		for (j = 0; j < 2; j++) {
+			const utf16_char_t *q = utf16;
+			utf8_char_t *b = utf8;
+			TEST(!utf16_to_utf8(&q, &b, 3*i - j, i));
+			TEST(q == utf16 + i - 1);
+			TEST(b == utf8 + l);
+		}
+	}
+	return 0;
+}
+
+static int test_utf32_to_utf8_long(void)
+{
+	static const utf32_char_t bad[] = {0xD800, 0xDBFF, 0xDC00, 0xDFFF, 0x110000, 0x80000000, 0xFFFFFFFF};
+	utf32_char_t utf32[200];
+	utf8_char_t utf8[800];
+	unsigned i = 0;
+	for (; i < sizeof(bad)/sizeof(bad[0]); i++) {
+		unsigned p = 0, l = 0;
+		for (; p + 1 < sizeof(utf32)/sizeof(utf32[0]); l += 1 + p % 4, p++) {
+			unsigned j = 0;
+			for (; j < sizeof(utf32)/sizeof(utf32[0]) - 1; j++)
+				utf32[j] = mixed_sample[j % 4].u;
+			utf32[j] = 0;
+			utf32[p] = bad[i];
+			{
+				const utf32_char_t *q = utf32;
+				utf8_char_t *b = utf8;
+				TEST(!utf32_to_utf8(&q, &b, sizeof(utf8), sizeof(utf32)/sizeof(utf32[0])));
+				TEST(q == utf32 + p);
+				TEST(b == utf8 + l);
+			}
+			{
+				const utf32_char_t *q = utf32;
+				utf8_char_t *b = utf8;
+				TEST(!utf32_to_utf8_z(&q, &b, sizeof(utf8)));
+				TEST(q == utf32 + p);
+				TEST(b == utf8 + l);
+			}
+			{
+				/* size-only pass must find invalid utf32 characters as well */
+				const utf32_char_t *q = utf32;
+				TEST(!utf32_to_utf8_size(&q, sizeof(utf32)/sizeof(utf32[0])));
+				TEST(q == utf32 + p);
+				q = utf32;
+				TEST(!utf32_to_utf8_z_size(&q));
+				TEST(q == utf32 + p);
+			}
+		}
+		if (!i) {
+			/* whole string without bad characters */
+			const utf32_char_t *q = utf32;
+			utf8_char_t *b = utf8;
+			utf32[sizeof(utf32)/sizeof(utf32[0]) - 2] = 0x10FFFF;
+			l += 4 - (1 + (sizeof(utf32)/sizeof(utf32[0]) - 2) % 4);
+			TEST(l + 1 == utf32_to_utf8(&q, &b, sizeof(utf8), sizeof(utf32)/sizeof(utf32[0])));
+			TEST(!memcmp(utf8 + l - 4, "\xF4\x8F\xBF\xBF", 5));
+			q = utf32;
+			TEST(l + 1 == utf32_to_utf8_size(&q, sizeof(utf32)/sizeof(utf32[0])));
+			q = utf32;
+			TEST(l + 1 == utf32_to_utf8_z_size(&q));
+		}
+	}
+	return 0;
+}
+
+static int test_utf16_to_utf32_long(void)
+{
+	static const struct {
+		utf16_char_t s[2];
+		unsigned n;
+	} bad[] = {
+		{{0xD800, 'a'}, 2}, {{0xDBFF, 0x430}, 2}, {{0xDBFF, 0xD800}, 2},
+		{{0xDC00, 0}, 1}, {{0xDFFF, 0}, 1}, {{0xDC00, 0xD800}, 2}
+	};
+	utf16_char_t utf16[200];
+	utf32_char_t utf32[200];
+	unsigned i = 0;
+	/* 'a', U+10437, 'a', U+10437, ... - surrogate pairs at all positions relative to a block of 16 */
+	for (; i < sizeof(utf16)/sizeof(utf16[0]) - 1; i++)
+		utf16[i] = (utf16_char_t)(!(i % 3) ? 'a' : (i % 3) == 1 ? 0xD801 : 0xDC37);
+	utf16[i] = 0;
+	{
+		const utf16_char_t *q = utf16;
+		utf32_char_t *b = utf32;
+		TEST(134 == utf16_to_utf32(&q, &b, sizeof(utf32)/sizeof(utf32[0]), sizeof(utf16)/sizeof(utf16[0])));
+		TEST(utf32[0] == 'a' && utf32[1] == 0x10437 && utf32[131] == 0x10437 && utf32[132] == 'a' && !utf32[133]);
+	}
+	{
+		const utf16_char_t *q = utf16;
+		utf32_char_t *b = utf32;
+		TEST(134 == utf16_to_utf32_z(&q, &b, sizeof(utf32)/sizeof(utf32[0])));
+		TEST(utf32[0] == 'a' && utf32[1] == 0x10437 && utf32[131] == 0x10437 && utf32[132] == 'a' && !utf32[133]);
+	}
+	{
+		const utf16_char_t *q = utf16;
+		TEST(134 == utf16_to_utf32_size(&q, sizeof(utf16)/sizeof(utf16[0])));
+		q = utf16;
+		TEST(134 == utf16_to_utf32_z_size(&q));
+	}
+	for (i = 0; i < sizeof(bad)/sizeof(bad[0]); i++) {
+		unsigned p = 0;
+		for (; p + 3 < sizeof(utf16)/sizeof(utf16[0]); p += 3) {
+			utf16_char_t t[2];
+			memcpy(t, utf16 + p, sizeof(t));
+			memcpy(utf16 + p, bad[i].s, bad[i].n*sizeof(utf16[0]));
+			{
+				const utf16_char_t *q = utf16;
+				utf32_char_t *b = utf32;
+				TEST(!utf16_to_utf32(&q, &b, sizeof(utf32)/sizeof(utf32[0]), sizeof(utf16)/sizeof(utf16[0])));
+				TEST(q == utf16 + p);
+				TEST(b == utf32 + 2*p/3);
+			}
+			{
+				const utf16_char_t *q = utf16;
+				utf32_char_t *b = utf32;
+				TEST(!utf16_to_utf32_z(&q, &b, sizeof(utf32)/sizeof(utf32[0])));
+				TEST(q == utf16 + p);
+				TEST(b == utf32 + 2*p/3);
+			}
+			{
+				/* size-only pass must find invalid utf16 characters as well */
+				const utf16_char_t *q = utf16;
+				TEST(!utf16_to_utf32_size(&q, sizeof(utf16)/sizeof(utf16[0])));
+				TEST(q == utf16 + p);
+				q = utf16;
+				TEST(!utf16_to_utf32_z_size(&q));
+				TEST(q == utf16 + p);
+			}
+			memcpy(utf16 + p, t, sizeof(t));
+		}
+	}
+	return 0;
+}
+
+static int test_utf32_to_utf16_long(void)
+{
+	static const utf32_char_t bad[] = {0xD800, 0xDBFF, 0xDC00, 0xDFFF, 0x110000, 0x80000000, 0xFFFFFFFF};
+	static const utf32_char_t fill[3] = {'a', 0x10437, 0xE000};
+	utf32_char_t utf32[200];
+	utf16_char_t utf16[300];
+	unsigned i = 0;
+	for (; i < sizeof(bad)/sizeof(bad[0]); i++) {
+		unsigned p = 0, l = 0;
+		for (; p + 1 < sizeof(utf32)/sizeof(utf32[0]); l += 1 + ((p % 3) == 1), p++) {
+			unsigned j = 0;
+			for (; j < sizeof(utf32)/sizeof(utf32[0]) - 1; j++)
+				utf32[j] = fill[j % 3];
+			utf32[j] = 0;
+			utf32[p] = bad[i];
+			{
+				const utf32_char_t *q = utf32;
+				utf16_char_t *b = utf16;
+				TEST(!utf32_to_utf16(&q, &b, sizeof(utf16)/sizeof(utf16[0]), sizeof(utf32)/sizeof(utf32[0])));
+				TEST(q == utf32 + p);
+				TEST(b == utf16 + l);
+			}
+			{
+				const utf32_char_t *q = utf32;
+				utf16_char_t *b = utf16;
+				TEST(!utf32_to_utf16_z(&q, &b, sizeof(utf16)/sizeof(utf16[0])));
+				TEST(q == utf32 + p);
+				TEST(b == utf16 + l);
+			}
+			{
+				/* size-only pass must find invalid utf32 characters as well */
+				const utf32_char_t *q = utf32;
+				TEST(!utf32_to_utf16_size(&q, sizeof(utf32)/sizeof(utf32[0])));
+				TEST(q == utf32 + p);
+				q = utf32;
+				TEST(!utf32_to_utf16_z_size(&q));
+				TEST(q == utf32 + p);
+			}
+		}
+		if (!i) {
+			/* whole string without bad characters */
+			const utf32_char_t *q = utf32;
+			utf16_char_t *b = utf16;
+			utf32[sizeof(utf32)/sizeof(utf32[0]) - 2] = 0x10FFFF;
+			TEST(l + 2 == utf32_to_utf16(&q, &b, sizeof(utf16)/sizeof(utf16[0]), sizeof(utf32)/sizeof(utf32[0])));
+			TEST(utf16[1] == 0xD801 && utf16[2] == 0xDC37 && utf16[3] == 0xE000);
+			TEST(utf16[l - 1] == 0xDBFF && utf16[l] == 0xDFFF && !utf16[l + 1]);
+			q = utf32;
+			TEST(l + 2 == utf32_to_utf16_size(&q, sizeof(utf32)/sizeof(utf32[0])));
+			q = utf32;
+			TEST(l + 2 == utf32_to_utf16_z_size(&q));
+		}
+	}
+	return 0;
+}
+
+static int test_utf8_to_utf16_short(void)
+{
+	utf8_char_t utf8[300];
+	utf16_char_t utf16[160], expected[160];
+	unsigned k = 0;
+	for (; k < 70; k++) {
+		/* string of k characters converted to buffers of exact size, the next utf16_char_t must not be touched */
+		unsigned i = 0, n = 0, l = 0;
+		for (; i < k; i++) {
+			const unsigned f = (i * 7 + k) % 4;
+			memcpy(utf8 + n, fill[f].s, fill[f].n);
+			n += fill[f].n;
+			expected[l++] = fill[f].c[0];
+			if (fill[f].c[1])
+				expected[l++] = fill[f].c[1];
+		}
+		utf8[n] = 0;
+		expected[l] = 0;
+		if (n) {
+			const utf8_char_t *q = utf8;
+			utf16_char_t *b = utf16;
+			utf16[l] = 0xFFFF;
+			TEST(l == utf8_to_utf16(&q, &b, l, n));
+			TEST(q == utf8 + n && b == utf16 + l);
+			TEST(!memcmp(utf16, expected, l*sizeof(utf16[0])) && utf16[l] == 0xFFFF);
+			q = utf8;
+			b = utf16;
+			utf16[l - 1] = 0xFFFF;
+			TEST(l - 1 < utf8_to_utf16_(&q, &b, l - 1, n, /*determ_size:*/0));
+			TEST(utf16[l - 1] == 0xFFFF);
+		}
+		{
+			const utf8_char_t *q = utf8;
+			utf16_char_t *b = utf16;
+			utf16[l + 1] = 0xFFFF;
+			TEST(l + 1 == utf8_to_utf16_z(&q, &b, l + 1));
+			TEST(q == utf8 + n + 1 && b == utf16 + l + 1);
+			TEST(!memcmp(utf16, expected, (l + 1)*sizeof(utf16[0])) && utf16[l + 1] == 0xFFFF);
+		}
+	}
+	return 0;
+}
+
+static int test_utf8_to_utf16_pad(void)
+{
+	utf8_char_t utf8[400 + UTF_BUF_PADDING];
+	utf16_char_t utf16[200 + UTF_BUF_PADDING/2 + 1], expected[200], swapped[200];
+	unsigned k = 1;
+	for (; k < 100; k++) {
+		/* padding of the input is filled with bytes of incomplete utf8 character, they must not be converted */
+		unsigned i = 0, n = 0, l = 0, sz;
+		for (; i < k; i++) {
+			const unsigned f = (i * 7 + k) % 4 * (k % 3 != 0);
+			memcpy(utf8 + n, fill[f].s, fill[f].n);
+			n += fill[f].n;
+			expected[l++] = fill[f].c[0];
+			if (fill[f].c[1])
+				expected[l++] = fill[f].c[1];
+		}
+		memset(utf8 + n, 0xF0, UTF_BUF_PADDING);
+		for (i = 0; i < l; i++)
+			swapped[i] = utf16_swap_bytes(expected[i]);
+		for (sz = 1; sz <= l; sz++) {
+			/* padding of the output buffer may be overwritten, but not beyond it */
+			const utf8_char_t *q = utf8, *q1 = utf8;
+			utf16_char_t *b = utf16, *b1 = utf16;
+			utf16[sz + UTF_BUF_PADDING/2] = 0xFFFF;
+			TEST(l == utf8_to_utf16_pad(&q, &b, sz, n));
+			TEST(utf16[sz + UTF_BUF_PADDING/2] == 0xFFFF);
+			TEST(!memcmp(utf16, expected, (size_t)(b - utf16)*sizeof(utf16[0])));
+			TEST(l == utf8_to_utf16(&q1, &b1, sz, n));
+			TEST(q == q1 && b == b1);
+			if (sz == l)
+				TEST(q == utf8 + n && b == utf16 + l);
+			q = utf8;
+			b = utf16;
+			TEST(sz < utf8_to_utf16_pad_partial(&q, &b, sz, n) || sz == l);
+			TEST(q == q1 && b == b1);
+			q = utf8;
+			b = utf16;
+			TEST(l == utf8_to_utf16x_pad(&q, &b, sz, n));
+			TEST(q == q1 && b == b1);
+			TEST(!memcmp(utf16, swapped, (size_t)(b - utf16)*sizeof(utf16[0])));
+			q = utf8;
+			b = utf16;
+			TEST(l == utf8_to_utf16ux_pad(&q, (utf16_char_unaligned_t**)&b, sz, n));
+			TEST(q == q1 && b == b1);
+			TEST(!memcmp(utf16, swapped, (size_t)(b - utf16)*sizeof(utf16[0])));
+		}
+		if (utf8[n - 1] >= 0x80) {
+			/* the last utf8 character is incomplete */
+			const utf8_char_t *q = utf8, *q1 = utf8;
+			utf16_char_t *b = utf16, *b1 = utf16;
+			TEST(!utf8_to_utf16_pad(&q, &b, l, n - 1));
+			TEST(!utf8_to_utf16(&q1, &b1, l, n - 1));
+			TEST(q == q1 && b == b1);
+		}
+		for (i = 0; i < n; i += 5) {
+			/* invalid utf8 character in the middle of the string */
+			const utf8_char_t *q = utf8, *q1 = utf8;
+			utf16_char_t *b = utf16, *b1 = utf16;
+			const utf8_char_t c = utf8[i];
+			utf8[i] = 0xFF;
+			TEST(!utf8_to_utf16_pad(&q, &b, l, n));
+			TEST(!utf8_to_utf16(&q1, &b1, l, n));
+			TEST(q == q1 && b == b1);
+			TEST(!memcmp(utf16, expected, (size_t)(b - utf16)*sizeof(utf16[0])));
+			utf8[i] = c;
+		}
+	}
+	return 0;
+}
+
+static int test_alloc(void)
+{
+	utf8_char_t utf8[400];
+	utf16_char_t utf16[200], swapped[200];
+	utf32_char_t utf32[100];
+	unsigned k = 1;
+	for (; k < 100; k++) {
+		unsigned i = 0, n = 0, l = 0;
+		int shrink = 0;
+		for (; i < k; i++) {
+			const unsigned f = (i * 5 + k) % 4 * (k % 3 != 0);
+			memcpy(utf8 + n, fill[f].s, fill[f].n);
+			n += fill[f].n;
+			utf16[l++] = fill[f].c[0];
+			if (fill[f].c[1])
+				utf16[l++] = fill[f].c[1];
+			utf32[i] = fill[f].u;
+		}
+		for (i = 0; i < l; i++)
+			swapped[i] = utf16_swap_bytes(utf16[i]);
+		for (; shrink < 2; shrink++) {
+			const utf8_char_t *q = utf8;
+			const utf16_char_t *w = utf16;
+			const utf32_char_t *d = utf32;
+			utf8_char_t *b8 = NULL;
+			utf16_char_t *b16 = NULL;
+			utf32_char_t *b32 = NULL;
+			TEST(l == utf8_to_utf16_alloc(&q, &b16, n, shrink));
+			TEST(q == utf8 + n && b16 && !memcmp(b16, utf16, l*sizeof(utf16[0])));
+			free(b16);
+			q = utf8;
+			TEST(l == utf8_to_utf16x_alloc(&q, &b16, n, shrink));
+			TEST(q == utf8 + n && b16 && !memcmp(b16, swapped, l*sizeof(utf16[0])));
+			free(b16);
+			q = utf8;
+			TEST(k == utf8_to_utf32_alloc(&q, &b32, n, shrink));
+			TEST(q == utf8 + n && b32 && !memcmp(b32, utf32, k*sizeof(utf32[0])));
+			free(b32);
+			TEST(n == utf16_to_utf8_alloc(&w, &b8, l, shrink));
+			TEST(w == utf16 + l && b8 && !memcmp(b8, utf8, n));
+			free(b8);
+			w = swapped;
+			TEST(n == utf16x_to_utf8_alloc(&w, &b8, l, shrink));
+			TEST(w == swapped + l && b8 && !memcmp(b8, utf8, n));
+			free(b8);
+			TEST(n == utf32_to_utf8_alloc(&d, &b8, k, shrink));
+			TEST(d == utf32 + k && b8 && !memcmp(b8, utf8, n));
+			free(b8);
+			w = utf16;
+			TEST(k == utf16_to_utf32_alloc(&w, &b32, l, shrink));
+			TEST(w == utf16 + l && b32 && !memcmp(b32, utf32, k*sizeof(utf32[0])));
+			free(b32);
+			d = utf32;
+			TEST(l == utf32_to_utf16x_alloc(&d, &b16, k, shrink));
+			TEST(d == utf32 + k && b16 && !memcmp(b16, swapped, l*sizeof(utf16[0])));
+			free(b16);
+			w = swapped;
+			TEST(k == utf16x_to_utf32_alloc(&w, &b32, l, shrink));
+			TEST(w == swapped + l && b32 && !memcmp(b32, utf32, k*sizeof(utf32[0])));
+			free(b32);
+		}
+		{
+			/* invalid input: nothing is allocated */
+			const utf8_char_t *q = utf8;
+			const utf16_char_t *w = utf16;
+			utf8_char_t *b8 = utf8;
+			utf16_char_t *b16 = utf16;
+			const utf8_char_t c = utf8[n - 1];
+			utf8[n - 1] = 0xFF;
+			TEST(!utf8_to_utf16_alloc(&q, &b16, n, 1));
+			TEST(!b16 && q >= utf8 && q < utf8 + n);
+			utf8[n - 1] = c;
+			utf16[l - 1] = 0xD800;
+			TEST(!utf16_to_utf8_alloc(&w, &b8, l, 1));
+			TEST(!b8 && w >= utf16 && w < utf16 + l);
+			q = utf8;
+			b16 = utf16;
+			TEST(!utf8_to_utf16_alloc(&q, &b16, 0, 1));
+			TEST(!b16 && q == utf8);
+		}
+	}
+	return 0;
+}
+
+static void *test_grow_realloc(void *ctx, void *buf, size_t size)
+{
+	(*(unsigned*)ctx)++;
+	return realloc(buf, size);
+}
+
+static int test_grow(void)
+{
+	utf8_char_t utf8[400];
+	utf16_char_t utf16[200];
+	utf32_char_t utf32[100];
+	unsigned k = 1;
+	for (; k < 100; k++) {
+		unsigned i = 0, n = 0, l = 0, c = 1, e;
+		for (; i < k; i++) {
+			const unsigned f = (i * 3 + k) % 4 * (k % 5 != 0);
+			memcpy(utf8 + n, fill[f].s, fill[f].n);
+			n += fill[f].n;
+			utf16[l++] = fill[f].c[0];
+			if (fill[f].c[1])
+				utf16[l++] = fill[f].c[1];
+			utf32[i] = fill[f].u;
+		}
+		for (; c <= 7; c += 3) {
+			/* convert by chunks of c units, each chunk may end with an incomplete character */
+			utf_grow_buf_t g16 = {NULL, 0, 0, NULL, NULL}, g8 = {NULL, 0, 0, NULL, NULL};
+			utf_grow_buf_t g32 = {NULL, 0, 1, NULL, NULL};
+			unsigned calls = 0;
+			const utf8_char_t *q = utf8;
+			const utf16_char_t *w = utf16;
+			const utf32_char_t *d = utf32;
+			g8.realloc_fn = test_grow_realloc;
+			g8.ctx = &calls;
+			g32.buf = malloc(sizeof(utf32_char_t));
+			TEST(g32.buf);
+			for (e = c;; e += c) {
+				size_t m;
+				if (e > n)
+					e = n;
+				m = utf8_to_utf16_grow(&q, &g16, e - (size_t)(q - utf8));
+				TEST(m != (size_t)-1);
+				TEST(m ? q == utf8 + e : (e != n && q + UTF8_MAX_LEN > utf8 + e));
+				if (e == n)
+					break;
+			}
+			TEST(g16.len == l && g16.cap >= l && !memcmp(g16.buf, utf16, l*sizeof(utf16[0])));
+			for (e = c;; e += c) {
+				size_t m;
+				if (e > l)
+					e = l;
+				m = utf16_to_utf8_grow(&w, &g8, e - (size_t)(w - utf16));
+				TEST(m != (size_t)-1);
+				TEST(m ? w == utf16 + e : (e != l && w + 1 == utf16 + e));
+				if (e == l)
+					break;
+			}
+			TEST(g8.len == n && g8.cap >= n && !memcmp(g8.buf, utf8, n));
+			/* capacity is at least doubled on each reallocation */
+			TEST(calls && ((size_t)1 << (calls - 1)) < 2*(size_t)n);
+			TEST(n == utf32_to_utf8_grow(&d, &g8, k));
+			TEST(d == utf32 + k && g8.len == 2*n && !memcmp((utf8_char_t*)g8.buf + n, utf8, n));
+			q = utf8;
+			TEST(k == utf8_to_utf32_grow(&q, &g32, n));
+			TEST(q == utf8 + n && g32.len == k && !memcmp(g32.buf, utf32, k*sizeof(utf32[0])));
+			d = utf32;
+			TEST(l == utf32_to_utf16_grow(&d, &g16, k));
+			TEST(d == utf32 + k && g16.len == 2*l && !memcmp((utf16_char_t*)g16.buf + l, utf16, l*sizeof(utf16[0])));
+			w = utf16;
+			TEST(k == utf16_to_utf32_grow(&w, &g32, l));
+			TEST(w == utf16 + l && g32.len == 2*k && !memcmp((utf32_char_t*)g32.buf + k, utf32, k*sizeof(utf32[0])));
+			/* invalid input: the valid part is converted and appended */
+			utf8[n] = 0xFF;
+			q = utf8;
+			TEST(!utf8_to_utf16_grow(&q, &g16, n + 1));
+			TEST(q == utf8 + n && g16.len == 3*l && !memcmp((utf16_char_t*)g16.buf + 2*l, utf16, l*sizeof(utf16[0])));
+			TEST(!utf8_to_utf16_grow(&q, &g16, 0));
+			TEST(q == utf8 + n && g16.len == 3*l);
+			free(g8.buf);
+			free(g16.buf);
+			free(g32.buf);
+		}
+	}
+	return 0;
+}
+
+static int test_token(void)
+{
+	utf8_char_t utf8[800], utf8_buf[800];
+	utf16_char_t utf16[400], swapped[400], utf16_buf[400];
+	utf32_char_t utf32[200], utf32_buf[200];
+	unsigned k = 1;
+	for (; k < 200; k += 7) {
+		unsigned i = 0, n = 0, l = 0;
+		utf_valid_token_t t;
+		const utf8_char_t *q = utf8;
+		const utf16_char_t *w = utf16;
+		const utf32_char_t *d = utf32;
+		utf8_char_t *b8 = utf8_buf;
+		utf16_char_t *b16 = utf16_buf;
+		utf32_char_t *b32 = utf32_buf;
+		for (; i < k; i++) {
+			/* runs of characters of the same length */
+			const unsigned f = (i/(k % 11 + 1) + k) % 4 * (k % 4 != 1);
+			memcpy(utf8 + n, fill[f].s, fill[f].n);
+			n += fill[f].n;
+			utf16[l++] = fill[f].c[0];
+			if (fill[f].c[1])
+				utf16[l++] = fill[f].c[1];
+			utf32[i] = fill[f].u;
+		}
+		for (i = 0; i < l; i++)
+			swapped[i] = utf16_swap_bytes(utf16[i]);
+		TEST(l == utf8_to_utf16_size_token(&q, n, &t));
+		TEST(q == utf8 && t.src == utf8 && t.n == n && t.size == l);
+		/* output buffer is too small: nothing is stored */
+		TEST(l == utf8_to_utf16_from_token(&t, &b16, l - 1));
+		TEST(b16 == utf16_buf);
+		TEST(l == utf8_to_utf16_from_token(&t, &b16, l));
+		TEST(b16 == utf16_buf + l && !memcmp(utf16_buf, utf16, l*sizeof(utf16[0])));
+		b16 = utf16_buf;
+		TEST(l == utf8_to_utf16ux_from_token(&t, (utf16_char_unaligned_t**)&b16, l + 1));
+		TEST(b16 == utf16_buf + l && !memcmp(utf16_buf, swapped, l*sizeof(utf16[0])));
+		TEST(k == utf8_to_utf32_size_token(&q, n, &t));
+		TEST(k == utf8_to_utf32_from_token(&t, &b32, k));
+		TEST(b32 == utf32_buf + k && !memcmp(utf32_buf, utf32, k*sizeof(utf32[0])));
+		TEST(n == utf16_to_utf8_size_token(&w, l, &t));
+		TEST(w == utf16 && t.src == utf16 && t.n == l && t.size == n);
+		TEST(n == utf16_to_utf8_from_token(&t, &b8, n));
+		TEST(b8 == utf8_buf + n && !memcmp(utf8_buf, utf8, n));
+		w = swapped;
+		b8 = utf8_buf;
+		TEST(n == utf16x_to_utf8_size_token(&w, l, &t));
+		TEST(n == utf16x_to_utf8_from_token(&t, &b8, n));
+		TEST(b8 == utf8_buf + n && !memcmp(utf8_buf, utf8, n));
+		b8 = utf8_buf;
+		TEST(n == utf32_to_utf8_size_token(&d, k, &t));
+		TEST(n == utf32_to_utf8_from_token(&t, &b8, n));
+		TEST(b8 == utf8_buf + n && !memcmp(utf8_buf, utf8, n));
+		w = utf16;
+		b32 = utf32_buf;
+		TEST(k == utf16_to_utf32_size_token(&w, l, &t));
+		TEST(k == utf16_to_utf32_from_token(&t, &b32, k));
+		TEST(b32 == utf32_buf + k && !memcmp(utf32_buf, utf32, k*sizeof(utf32[0])));
+		b16 = utf16_buf;
+		TEST(l == utf32_to_utf16x_size_token(&d, k, &t));
+		TEST(l == utf32_to_utf16x_from_token(&t, &b16, l));
+		TEST(b16 == utf16_buf + l && !memcmp(utf16_buf, swapped, l*sizeof(utf16[0])));
+		/* a token is accepted only by the same conversion with the same form of input */
+		q = utf8;
+		b16 = utf16_buf;
+		memset(utf16_buf, 0xFF, sizeof(utf16_buf));
+		TEST(k == utf8_to_utf32_size_token(&q, n, &t));
+		TEST(!utf8_to_utf16_from_token(&t, &b16, sizeof(utf16_buf)/sizeof(utf16_buf[0])));
+		TEST(b16 == utf16_buf && utf16_buf[0] == 0xFFFF);
+		w = utf16;
+		b8 = utf8_buf;
+		TEST(n == utf16_to_utf8_size_token(&w, l, &t));
+		TEST(!utf16x_to_utf8_from_token(&t, &b8, sizeof(utf8_buf)));
+		TEST(!utf16u_to_utf8_from_token(&t, &b8, sizeof(utf8_buf)));
+		TEST(!utf32_to_utf8_from_token(&t, &b8, sizeof(utf8_buf)));
+		TEST(b8 == utf8_buf);
+		b32 = utf32_buf;
+		TEST(k == utf16_to_utf32_size_token(&w, l, &t));
+		TEST(!utf16x_to_utf32_from_token(&t, &b32, sizeof(utf32_buf)/sizeof(utf32_buf[0])));
+		TEST(!utf32_to_utf16_from_token(&t, &b16, sizeof(utf16_buf)/sizeof(utf16_buf[0])));
+		TEST(b32 == utf32_buf && b16 == utf16_buf && utf16_buf[0] == 0xFFFF);
+		/* 0-terminated input: the token covers the terminating 0, which is converted too */
+		utf8[n] = 0;
+		utf16[l] = 0;
+		swapped[l] = 0;
+		utf32[k] = 0;
+		q = utf8;
+		TEST(l + 1 == utf8_to_utf16_z_size_token(&q, &t));
+		TEST(q == utf8 && t.src == utf8 && t.n == n + 1 && t.size == l + 1);
+		TEST(l + 1 == utf8_to_utf16_from_token(&t, &b16, l + 1));
+		TEST(b16 == utf16_buf + l + 1 && !memcmp(utf16_buf, utf16, (l + 1)*sizeof(utf16[0])));
+		b32 = utf32_buf;
+		TEST(k + 1 == utf8_to_utf32_z_size_token(&q, &t));
+		TEST(k + 1 == utf8_to_utf32_from_token(&t, &b32, k + 1));
+		TEST(b32 == utf32_buf + k + 1 && !memcmp(utf32_buf, utf32, (k + 1)*sizeof(utf32[0])));
+		w = swapped;
+		b8 = utf8_buf;
+		TEST(n + 1 == utf16x_to_utf8_z_size_token(&w, &t));
+		TEST(w == swapped && t.src == swapped && t.n == l + 1 && t.size == n + 1);
+		TEST(!utf16_to_utf8_from_token(&t, &b8, n + 1));
+		TEST(n + 1 == utf16x_to_utf8_from_token(&t, &b8, n + 1));
+		TEST(b8 == utf8_buf + n + 1 && !memcmp(utf8_buf, utf8, n + 1));
+		w = utf16;
+		b32 = utf32_buf;
+		TEST(k + 1 == utf16_to_utf32_z_size_token(&w, &t));
+		TEST(k + 1 == utf16_to_utf32_from_token(&t, &b32, k + 1));
+		TEST(b32 == utf32_buf + k + 1 && !memcmp(utf32_buf, utf32, (k + 1)*sizeof(utf32[0])));
+		b8 = utf8_buf;
+		TEST(n + 1 == utf32_to_utf8_z_size_token(&d, &t));
+		TEST(d == utf32 && t.n == k + 1);
+		TEST(n + 1 == utf32_to_utf8_from_token(&t, &b8, n + 1));
+		TEST(b8 == utf8_buf + n + 1 && !memcmp(utf8_buf, utf8, n + 1));
+		b16 = utf16_buf;
+		TEST(l + 1 == utf32_to_utf16x_z_size_token(&d, &t));
+		TEST(l + 1 == utf32_to_utf16x_from_token(&t, &b16, l + 1));
+		TEST(b16 == utf16_buf + l + 1 && !memcmp(utf16_buf, swapped, (l + 1)*sizeof(utf16[0])));
+		/* invalid input: the token is empty */
+		utf8[n - 1] = 0xFF;
+		b16 = utf16_buf;
+		TEST(!utf8_to_utf16_size_token(&q, n, &t));
+		TEST(q != utf8 + n && !t.src && !t.n && !t.size && !t.kind);
+		TEST(!utf8_to_utf16_from_token(&t, &b16, l));
+		TEST(b16 == utf16_buf);
+		q = utf8;
+		TEST(!utf8_to_utf16_z_size_token(&q, &t));
+		TEST(q < utf8 + n && !t.src && !t.n && !t.size && !t.kind);
+		q = utf8;
+		TEST(!utf8_to_utf16_size_token(&q, 0, &t));
+		TEST(q == utf8 && !t.src && !t.n && !t.size && !t.kind);
+	}
+	return 0;
+}
+
+static unsigned test_arena_chunks(const utf_arena_t *const a)
+{
+	unsigned c = 0;
+	const utf_arena_chunk_t *k = a->first;
+	for (; k; k = k->next)
+		c++;
+	return c;
+}
+
+static int test_arena(void)
+{
+	utf8_char_t utf8[400];
+	utf16_char_t utf16[200], swapped[200];
+	utf32_char_t utf32[100];
+	utf_arena_t a;
+	unsigned k = 1;
+	/* small chunks: long strings are converted to buffers of exact size */
+	utf_arena_init(&a, 256);
+	for (; k < 100; k += 3) {
+		unsigned i = 0, n = 0, l = 0;
+		const utf8_char_t *q = utf8;
+		const utf16_char_t *w = utf16;
+		const utf32_char_t *d = utf32;
+		utf8_char_t *b8 = NULL;
+		utf16_char_t *b16 = NULL, *first = NULL;
+		utf32_char_t *b32 = NULL;
+		const utf_arena_chunk_t *c;
+		const unsigned char *p;
+		for (; i < k; i++) {
+			const unsigned f = (i * 5 + k) % 4 * (k % 3 != 0);
+			memcpy(utf8 + n, fill[f].s, fill[f].n);
+			n += fill[f].n;
+			utf16[l++] = fill[f].c[0];
+			if (fill[f].c[1])
+				utf16[l++] = fill[f].c[1];
+			utf32[i] = fill[f].u;
+		}
+		for (i = 0; i < l; i++)
+			swapped[i] = utf16_swap_bytes(utf16[i]);
+		TEST(l == utf8_to_utf16_arena(&q, &first, n, &a));
+		TEST(q == utf8 + n && first && !memcmp(first, utf16, l*sizeof(utf16[0])));
+		TEST(!((uintptr_t)first % UTF_ARENA_ALIGN));
+		q = utf8;
+		TEST(l == utf8_to_utf16x_arena(&q, &b16, n, &a));
+		TEST(q == utf8 + n && b16 && !memcmp(b16, swapped, l*sizeof(utf16[0])));
+		TEST(!((uintptr_t)b16 % UTF_ARENA_ALIGN));
+		q = utf8;
+		TEST(k == utf8_to_utf32_arena(&q, &b32, n, &a));
+		TEST(q == utf8 + n && b32 && !memcmp(b32, utf32, k*sizeof(utf32[0])));
+		TEST(!((uintptr_t)b32 % UTF_ARENA_ALIGN));
+		TEST(n == utf16_to_utf8_arena(&w, &b8, l, &a));
+		TEST(w == utf16 + l && b8 && !memcmp(b8, utf8, n));
+		TEST(!((uintptr_t)b8 % UTF_ARENA_ALIGN));
+		w = swapped;
+		TEST(n == utf16x_to_utf8_arena(&w, &b8, l, &a));
+		TEST(w == swapped + l && b8 && !memcmp(b8, utf8, n));
+		TEST(n == utf32_to_utf8_arena(&d, &b8, k, &a));
+		TEST(d == utf32 + k && b8 && !memcmp(b8, utf8, n));
+		w = utf16;
+		TEST(k == utf16_to_utf32_arena(&w, &b32, l, &a));
+		TEST(w == utf16 + l && b32 && !memcmp(b32, utf32, k*sizeof(utf32[0])));
+		d = utf32;
+		TEST(l == utf32_to_utf16x_arena(&d, &b16, k, &a));
+		TEST(d == utf32 + k && b16 && !memcmp(b16, swapped, l*sizeof(utf16[0])));
+		w = swapped;
+		TEST(k == utf16x_to_utf32_arena(&w, &b32, l, &a));
+		TEST(w == swapped + l && b32 && !memcmp(b32, utf32, k*sizeof(utf32[0])));
+		/* blocks allocated before are not overwritten */
+		TEST(!memcmp(first, utf16, l*sizeof(utf16[0])));
+		/* invalid input: nothing is allocated */
+		c = a.cur;
+		p = a.pos;
+		q = utf8;
+		utf8[n - 1] = 0xFF;
+		TEST(!utf8_to_utf16_arena(&q, &b16, n, &a));
+		TEST(!b16 && q >= utf8 && q < utf8 + n);
+		TEST(a.cur != c || a.pos == p);
+		c = a.cur;
+		p = a.pos;
+		w = utf16;
+		utf16[l - 1] = 0xD800;
+		TEST(!utf16_to_utf8_arena(&w, &b8, l, &a));
+		TEST(!b8 && w >= utf16 && w < utf16 + l);
+		TEST(a.cur != c || a.pos == p);
+		c = a.cur;
+		p = a.pos;
+		q = utf8;
+		b16 = utf16;
+		TEST(!utf8_to_utf16_arena(&q, &b16, 0, &a));
+		TEST(!b16 && q == utf8 && a.cur == c && a.pos == p);
+	}
+	{
+		/* after reset, kept chunks are reused */
+		static const utf8_char_t ascii[] = "0123456789";
+		const unsigned chunks = test_arena_chunks(&a);
+		utf16_char_t *b16 = NULL;
+		TEST(chunks > 1);
+		utf_arena_reset(&a);
+		TEST(a.first && !a.cur);
+		for (k = 0; k < 20; k++) {
+			const utf8_char_t *q = ascii;
+			TEST(10 == utf8_to_utf16_arena(&q, &b16, 10, &a));
+			TEST(q == ascii + 10 && b16 && b16[0] == '0' && b16[9] == '9');
+			TEST(k || b16 == (utf16_char_t*)(a.first + 1));
+		}
+		TEST(chunks == test_arena_chunks(&a));
+		utf_arena_destroy(&a);
+		TEST(!a.first && !a.cur && !a.pos && a.chunk_size == 256);
+	}
+	return 0;
+}
+
+static int test_to_utf8_short(void)
+{
+	utf32_char_t utf32[80];
+	utf16_char_t utf16[160];
+	utf8_char_t utf8[330], expected[330];
+	unsigned k = 1;
+	for (; k < 70; k++) {
+		/* strings of k characters converted to buffers of exact size, the next utf8_char_t must not be touched */
+		unsigned i = 0, n = 0, l = 0;
+		for (; i < k; i++) {
+			const unsigned f = (i * 5 + k) % 4;
+			utf32[i] = fill[f].c;
+			if (fill[f].c > 0xFFFF) {
+				utf16[l++] = (utf16_char_t)(0xD800 + ((fill[f].c - 0x10000) >> 10));
+				utf16[l++] = (utf16_char_t)(0xDC00 + (fill[f].c & 0x3FF));
+			}
+			else
+				utf16[l++] = (utf16_char_t)fill[f].c;
+			memcpy(expected + n, fill[f].s, fill[f].n);
+			n += fill[f].n;
+		}
+		utf32[k] = 0;
+		utf16[l] = 0;
+		expected[n] = 0;
+		{
+			const utf16_char_t *q = utf16;
+			utf8_char_t *b = utf8;
+			utf8[n] = 0xFF;
+			TEST(n == utf16_to_utf8(&q, &b, n, l));
+			TEST(q == utf16 + l && b == utf8 + n);
+			TEST(!memcmp(utf8, expected, n) && utf8[n] == 0xFF);
+			q = utf16;
+			b = utf8;
+			utf8[n - 1] = 0xFF;
+			TEST(n - 1 < utf16_to_utf8_(&q, &b, n - 1, l, /*determ_size:*/0));
+			TEST(utf8[n - 1] == 0xFF);
+		}
+		{
+			const utf16_char_t *q = utf16;
+			utf8_char_t *b = utf8;
+			utf8[n + 1] = 0xFF;
+			TEST(n + 1 == utf16_to_utf8_z(&q, &b, n + 1));
+			TEST(q == utf16 + l + 1 && b == utf8 + n + 1);
+			TEST(!memcmp(utf8, expected, n + 1) && utf8[n + 1] == 0xFF);
+		}
+		{
+			const utf32_char_t *q = utf32;
+			utf8_char_t *b = utf8;
+			utf8[n] = 0xFF;
+			TEST(n == utf32_to_utf8(&q, &b, n, k));
+			TEST(q == utf32 + k && b == utf8 + n);
+			TEST(!memcmp(utf8, expected, n) && utf8[n] == 0xFF);
+			q = utf32;
+			b = utf8;
+			utf8[n - 1] = 0xFF;
+			TEST(n - 1 < utf32_to_utf8_(&q, &b, n - 1, k, /*determ_size:*/0));
+			TEST(utf8[n - 1] == 0xFF);
+		}
+		{
+			const utf32_char_t *q = utf32;
+			utf8_char_t *b = utf8;
+			utf8[n + 1] = 0xFF;
+			TEST(n + 1 == utf32_to_utf8_z(&q, &b, n + 1));
+			TEST(q == utf32 + k + 1 && b == utf8 + n + 1);
+			TEST(!memcmp(utf8, expected, n + 1) && utf8[n + 1] == 0xFF);
+		}
+	}
+	return 0;
+}
+
 static int test_utf8_to_utf32(
 	const unsigned initial_step,
 	const utf32_char_t *const utf32_le_be[2],
@@ -777,6 +2253,34 @@ static int test_utf8_to_utf32_one_z(
 	return 0;
 }
 
+static int test_utf8_to_utf32_one_z_4byte(void)
+{
+	/* all 4-byte utf8 characters, in particular U+100000..U+10FFFF with the F4 lead byte */
+	utf8_char_t s[5] = {0, 0, 0, 0, 0};
+	utf32_char_t c = 0x10000;
+	for (; c <= 0x10FFFF; c++) {
+		utf32_char_t w = 0;
+		s[0] = (utf8_char_t)(0xF0 | (c >> 18));
+		s[1] = (utf8_char_t)(0x80 | ((c >> 12) & 0x3F));
+		s[2] = (utf8_char_t)(0x80 | ((c >> 6) & 0x3F));
+		s[3] = (utf8_char_t)(0x80 | (c & 0x3F));
+		TEST(utf8_to_utf32_one_z(&w, s) == s + 4);
+		TEST(w == c);
+	}
+	/* code points above U+10FFFF are rejected */
+	{
+		static const utf8_char_t too_big[][5] = {
+			{0xF4, 0x90, 0x80, 0x80, 0}, {0xF4, 0xBF, 0xBF, 0xBF, 0}, {0xF5, 0x80, 0x80, 0x80, 0}
+		};
+		unsigned i = 0;
+		for (; i < sizeof(too_big)/sizeof(too_big[0]); i++) {
+			utf32_char_t w;
+			TEST(!utf8_to_utf32_one_z(&w, too_big[i]));
+		}
+	}
+	return 0;
+}
+
 static int test_utf8_mblen(
 	const unsigned utf32_sz,
 	const unsigned utf8_sz,
@@ -2184,6 +3688,37 @@ static int test_utf8_mbsrtocs_or_csrtombs(
 
 #include "test_data.inl"
 
+/* run conversions of long strings with all engines, down to scalar one */
+static int test_engines(void)
+{
+	int e = LIBUTF16_ENGINE_AVX512;
+	for (; e >= LIBUTF16_ENGINE_SCALAR; e--) {
+		const int used = libutf16_set_engine(e);
+		TEST(LIBUTF16_ENGINE_SCALAR <= used && used <= e);
+		TEST(used == libutf16_engine());
+		TEST(!test_utf8_to_utf16_edge());
+		TEST(!test_utf8_long());
+		TEST(!test_utf8_to_utf16_short());
+		TEST(!test_utf8_to_utf16_pad());
+		TEST(!test_alloc());
+		TEST(!test_grow());
+		TEST(!test_token());
+		TEST(!test_arena());
+		TEST(!test_to_utf8_short());
+		TEST(!test_ascii_runs());
+		TEST(!test_unaligned());
+		TEST(!test_page_end());
+		TEST(!test_short_page_end());
+		TEST(!test_validate());
+		TEST(!test_utf16_to_utf8_long());
+		TEST(!test_utf32_to_utf8_long());
+		TEST(!test_utf16_to_utf32_long());
+		TEST(!test_utf32_to_utf16_long());
+	}
+	TEST(libutf16_set_engine(-1) == libutf16_engine());
+	return 0;
+}
+
 int main(int argc, char *argv[])
 {
 #ifdef CHECK_UTF8_LOCALE
@@ -2519,6 +4054,8 @@ int main(int argc, char *argv[])
 				32, 16));
 		}
 	}
+	TEST(!test_utf8_to_utf32_one_z_4byte());
+	TEST(!test_engines());
 	printf("All tests ok\n");
 	(void)argc, (void)argv;
 	return 0;